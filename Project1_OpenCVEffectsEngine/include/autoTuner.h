@@ -0,0 +1,100 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * autoTuner.h
+ * Picks the fastest implementation of a filter for the frame size and thread
+ * count actually in use. Each filter has a list of interchangeable variants
+ * (serial, separable, band-parallel, ...). The first frames at a new
+ * resolution run the variants in turn and time them, or calibrate() times
+ * them all up front; the winner is written to a small cache file and every
+ * later call dispatches straight to it. A per-filter override skips the
+ * tuning, and printReport() lists every choice with the timings behind it.
+ *
+ * Cache file, one line per filter/resolution/type/thread count:
+ *   <filter> <width> <height> <type> <threads> <variant> <median ms>
+ */
+
+#ifndef AUTO_TUNER_H
+#define AUTO_TUNER_H
+
+#include <opencv2/opencv.hpp>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Same signature as the classic filters in filters.h
+typedef std::function<int(cv::Mat &, cv::Mat &)> KernelFn;
+
+// Where a filter's current choice came from
+enum TuneSource {
+    TUNE_PENDING,       // still timing variants on live frames
+    TUNE_ONLINE,        // timed on the first frames at this resolution
+    TUNE_CALIBRATED,    // timed by calibrate()
+    TUNE_CACHE          // read from the cache file
+};
+
+class AutoTuner {
+private:
+    struct Variant {
+        std::string name;
+        KernelFn fn;
+    };
+
+    // Tuning state and result for one filter at one resolution, type and thread count
+    struct Choice {
+        std::string filter;
+        cv::Size size;
+        int type = 0;
+        int threads = 0;
+        TuneSource source = TUNE_PENDING;
+        int runs = 0;
+        std::vector<std::vector<double>> samples;   // per variant, warm-up run excluded
+        std::vector<double> medians;                // per variant, filled when decided
+        std::string winner;
+        double winnerMs = 0;
+    };
+
+    std::string cachePath;
+    int samplesPerVariant;
+    std::map<std::string, std::vector<Variant>> variants;
+    std::map<std::string, Choice> choices;
+    std::map<std::string, std::string> overrides;
+
+    Choice &choiceFor(const std::string &filter, const cv::Mat &src);
+    int variantIndex(const std::string &filter, const std::string &name) const;
+    void decide(Choice &choice, TuneSource source);
+    void loadCache();
+    void saveCache() const;
+
+public:
+    // cachePath may be empty to tune every run from scratch
+    AutoTuner(const std::string &cachePath, int samplesPerVariant = 5);
+
+    // Add an implementation of filter; variants of a filter should produce the same image
+    void registerVariant(const std::string &filter, const std::string &name, KernelFn fn);
+
+    // Always use this variant of filter; false if no such variant is registered
+    bool setOverride(const std::string &filter, const std::string &name);
+
+    // Run filter on src with the chosen variant, timing the next variant in line while still tuning
+    int run(const std::string &filter, cv::Mat &src, cv::Mat &dst);
+
+    // Time every variant of every filter on src now and store the winners
+    void calibrate(cv::Mat &src, int repetitions = 10);
+
+    // What was picked for each filter and resolution, and why
+    void printReport() const;
+};
+
+// Wrap a filter that keeps the frame type so horizontal bands of the frame run in parallel;
+// halo is how many rows past its band the filter reads
+KernelFn bandParallel(KernelFn fn, int halo);
+
+// The greyscale, sepia and blur variants used by vidDisplay
+void registerStandardVariants(AutoTuner &tuner);
+
+#endif
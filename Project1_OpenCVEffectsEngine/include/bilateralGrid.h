@@ -0,0 +1,34 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * bilateralGrid.h
+ * Edge-preserving smoothing in linear time with a bilateral grid (Chen, Paris
+ * and Durand). Pixels are splatted into a coarse 3D grid indexed by position
+ * and luma, the grid is blurred with a small separable kernel, and every pixel
+ * reads its result back by trilinear interpolation. Work grows with the pixel
+ * count plus the (small) grid size, not with the spatial sigma, so wide
+ * smoothing windows cost the same as narrow ones.
+ */
+
+#ifndef BILATERAL_GRID_H
+#define BILATERAL_GRID_H
+
+#include <opencv2/opencv.hpp>
+
+// Smooth an 8UC1 or 8UC3 image across regions of similar luma but not across edges.
+// sigmaSpatial is the grid cell size in pixels, sigmaRange the cell depth in luma levels.
+int bilateralGridFilter(const cv::Mat &src, cv::Mat &dst, float sigmaSpatial = 16.0f, float sigmaRange = 24.0f);
+
+// Cartoon effect with bilateral-grid smoothing instead of the 5x5 Gaussian
+int blurQuantizeBilateral(cv::Mat &src, cv::Mat &dst, int levels);
+
+// Pencil sketch drawn from the bilateral-grid smoothed frame, so texture does not become strokes
+int sketchBilateral(cv::Mat &src, cv::Mat &dst);
+
+// Speed of the grid against cv::bilateralFilter at 720p and 1080p, with PSNR between them
+void testBilateralGrid(cv::Mat &testImage);
+
+#endif
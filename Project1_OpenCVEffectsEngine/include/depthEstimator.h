@@ -12,6 +12,10 @@
 
 #include <opencv2/opencv.hpp>
 
-int estimateDepth(cv::Mat &src, cv::Mat &dst);
+// Estimate an 8-bit depth map (255 = near); blurSize is the odd Gaussian smoothing window
+int estimateDepth(cv::Mat &src, cv::Mat &dst, int blurSize = 31);
+
+// Same estimate from an existing 8-bit luma image, skipping the color conversion
+int estimateDepthGray(cv::Mat &gray, cv::Mat &dst, int blurSize = 31);
 
 #endif
\ No newline at end of file
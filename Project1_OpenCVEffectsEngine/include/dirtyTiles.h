@@ -0,0 +1,73 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * dirtyTiles.h
+ * Change detection for static-camera feeds. Frames are split into tiles, each
+ * tile is compared against the luma it was last rendered from, and stateless
+ * spatial filters recompute only the tiles that changed.
+ */
+
+#ifndef DIRTY_TILES_H
+#define DIRTY_TILES_H
+
+#include <opencv2/opencv.hpp>
+#include <functional>
+#include <vector>
+
+// Per-tile change detector using SAD on luma sampled every 4th pixel
+class DirtyTileTracker {
+private:
+    int tileSize;
+    int threshold;
+    cv::Size frameSize;
+    int tilesX;
+    int tilesY;
+    bool forceAll;
+
+    cv::Mat current;        // sampled luma of the latest frame
+    cv::Mat reference;      // sampled luma each tile was last rendered from
+    std::vector<unsigned char> dirty;
+    int dirtyCount;
+    std::vector<cv::Rect> pendingRects;   // forced dirty on the next update
+
+    long long tilesSeen;
+    long long tilesSkipped;
+
+public:
+    // tileSize is rounded up to a multiple of 4; threshold is the mean absolute luma difference per sample
+    DirtyTileTracker(int tileSize = 32, int threshold = 6);
+
+    // Mark changed tiles for this frame; returns the number of dirty tiles
+    int update(cv::Mat &frame);
+
+    // Force every tile dirty on the next update (effect switched, output discarded)
+    void invalidate() { forceAll = true; }
+
+    // Force the tiles under rect dirty on the next update (output drawn over, e.g. text overlays)
+    void invalidateRect(cv::Rect rect) { pendingRects.push_back(rect); }
+
+    bool isDirty(int tx, int ty) const { return dirty[ty * tilesX + tx] != 0; }
+    bool allDirty() const { return dirtyCount == tilesX * tilesY; }
+
+    int getTileSize() const { return tileSize; }
+    int getTilesX() const { return tilesX; }
+    int getTilesY() const { return tilesY; }
+
+    int getThreshold() const { return threshold; }
+    void setThreshold(int value) { threshold = std::max(0, value); }
+
+    // Percentage of tiles skipped in the latest frame and since start
+    double lastSkippedPercent() const;
+    double totalSkippedPercent() const;
+    void printStats() const;
+};
+
+// Run filter only over dirty tiles (grown by halo pixels for the filter's stencil) and keep
+// the previous dst elsewhere; falls back to a full-frame run when everything changed
+int applyTiled(std::function<int(cv::Mat &, cv::Mat &)> filter, cv::Mat &src, cv::Mat &dst,
+               DirtyTileTracker &tracker, int halo);
+
+#endif
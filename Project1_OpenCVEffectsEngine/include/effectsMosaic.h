@@ -0,0 +1,107 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * effectsMosaic.h
+ * Grid view rendering every effect from the same camera frame at once. The
+ * frame is downscaled to tile size once, the intermediates several effects
+ * share (luma, gradients, blur, depth, faces) are computed once per frame,
+ * and the tiles are rendered in parallel on a persistent worker pool. Doubles
+ * as a throughput stress test for the whole filter library.
+ */
+
+#ifndef EFFECTS_MOSAIC_H
+#define EFFECTS_MOSAIC_H
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Renders all effects into one grid image
+class EffectsMosaic {
+private:
+    // One parallel step; tasks are claimed through next and counted down in pending
+    struct Batch {
+        std::vector<std::function<void()>> tasks;
+        std::atomic<int> next;
+        int pending;
+    };
+
+    struct Effect {
+        std::string name;
+        std::function<int(cv::Mat &)> render;
+        double totalMs;
+    };
+
+    std::vector<Effect> effects;
+    int columns;
+
+    // Worker pool shared by both steps of a frame
+    std::vector<std::thread> workers;
+    std::mutex lock;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::shared_ptr<Batch> batch;
+    long long generation;
+    bool stopping;
+
+    // Per-frame shared intermediates, all at tile resolution
+    cv::Mat small;
+    cv::Mat gray;
+    cv::Mat gradX, gradY;
+    cv::Mat lumaGradX, lumaGradY;
+    cv::Mat blurred;
+    cv::Mat depth;
+    cv::Mat detectGray;
+    std::vector<cv::Rect> faces;
+    unsigned int seed;
+    int cartoonLevels;
+
+    // Second blur pass, only touched by the depth focus tile
+    cv::Mat blurredTwice;
+
+    // Rendered tiles, reused across frames
+    std::vector<cv::Mat> tiles;
+
+    long long framesRendered;
+    double totalFrameMs;
+    double totalSharedMs;
+    double lastMs;
+
+    void addEffects();
+    void run();
+    bool runTask(Batch &work);
+    void runBatch(std::vector<std::function<void()>> tasks);
+
+public:
+    // columns = 0 picks a near-square grid; workerCount = 0 uses every hardware thread
+    EffectsMosaic(int columns = 0, int workerCount = 0);
+
+    // Joins the worker threads
+    ~EffectsMosaic();
+
+    // Render the grid for an 8-bit BGR frame into dst (same size as frame); 0 on success
+    int render(const cv::Mat &frame, cv::Mat &dst);
+
+    // Color levels used by the cartoon tile
+    void setCartoonLevels(int levels) { cartoonLevels = levels; }
+
+    // Number of tiles in the grid
+    int getEffectCount() const { return (int)effects.size(); }
+
+    // Wall time of the last render() in milliseconds
+    double lastFrameMs() const { return lastMs; }
+
+    // Frames/s, effects/s and the average cost of each tile
+    void printStats() const;
+};
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * faceFeatures.h
+ * Nested eye and smile detection restricted to detected faces. Each face's
+ * eye band and mouth band are scaled to a fixed size and packed side by side
+ * into one strip per cascade, so every frame costs one eye call and one smile
+ * call however many faces there are, and the two calls run in parallel.
+ */
+
+#ifndef FACE_FEATURES_H
+#define FACE_FEATURES_H
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// One face and the features found inside it, all in frame coordinates
+struct FaceFeatures {
+    cv::Rect face;
+    std::vector<cv::Rect> eyes;     // at most two, left to right
+    std::vector<cv::Rect> smiles;   // at most one
+};
+
+// Load the eye and smile cascades now instead of on first use (thread-safe)
+int preloadFaceFeatureCascades();
+
+// Head rectangle for face re-centred on its eyes when both were found (for overlay alignment)
+cv::Rect alignedFace(const FaceFeatures &features);
+
+// Runs the face, eye and smile stages and keeps per-stage timings
+class FaceFeatureDetector {
+private:
+    double faceMs;
+    double packMs;
+    double eyeMs;
+    double smileMs;
+    long long frames;
+    long long facesSeen;
+    long long eyesFound;
+    long long smilesFound;
+
+public:
+    FaceFeatureDetector();
+
+    // Detect faces in an 8-bit luma image, then the features inside them
+    int detect(cv::Mat &gray, std::vector<FaceFeatures> &features);
+
+    // Detect features inside faces that were already found
+    int detectInFaces(cv::Mat &gray, const std::vector<cv::Rect> &faces, std::vector<FaceFeatures> &features);
+
+    // Average ms per frame for each stage, and hit counts
+    void printStats() const;
+};
+
+#endif
@@ -15,52 +15,103 @@
 
 #include <opencv2/opencv.hpp>
 
-// Custom grayscale conversion using inverted red channel
+// Custom grayscale conversion using inverted red channel (8UC1/3/4, 16UC1/3)
 int greyscale(cv::Mat &src, cv::Mat &dst);
 
-// Sepia tone filter for vintage photograph effect
+// Sepia tone filter for vintage photograph effect (8UC1/3/4, 16UC1/3)
 int sepia(cv::Mat &src, cv::Mat &dst);
 
-// Naive 5x5 Gaussian blur using full kernel
+// Naive 5x5 Gaussian blur using full kernel (8UC1/3/4, 16UC1/3)
 int blur5x5_1(cv::Mat &src, cv::Mat &dst);
 
-// Optimized 5x5 Gaussian blur using separable filters
+// Optimized 5x5 Gaussian blur using separable filters (8U/16U, 1/3/4 channels, in-place safe)
 int blur5x5_2(cv::Mat &src, cv::Mat &dst);
 
-// Sobel X filter for vertical edge detection (returns signed short)
+// Sobel X filter for vertical edge detection (signed short; int for 16-bit input)
 int sobelX3x3(cv::Mat &src, cv::Mat &dst);
 
-// Sobel Y filter for horizontal edge detection (returns signed short)
+// Sobel Y filter for horizontal edge detection (signed short; int for 16-bit input)
 int sobelY3x3(cv::Mat &src, cv::Mat &dst);
 
-// Compute gradient magnitude from Sobel X and Y outputs
-int magnitude(cv::Mat &sx, cv::Mat &sy, cv::Mat &dst);
+// Gradient magnitude accuracy/speed trade-offs; every mode clamps to the output range.
+// Error bounds are relative to sqrt(gx^2 + gy^2) before clamping.
+enum MagnitudeMode {
+    MAGNITUDE_EXACT,                // float sqrt, truncated (reference)
+    MAGNITUDE_INT_SQRT,             // 64 KB integer sqrt table, bit-exact with MAGNITUDE_EXACT (16-bit output uses the exact path)
+    MAGNITUDE_L1,                   // |gx| + |gy|: 0% to +41.4%
+    MAGNITUDE_ALPHA_MAX_BETA_MIN    // 15/16 max + 15/32 min: -6.25% to +4.8%, then -1 from truncation
+};
 
-// Cartoon effect combining blur, color quantization, and edge darkening
+// Compute gradient magnitude from Sobel X and Y outputs (16S -> 8U, 32S -> 16U, any channel count)
+int magnitude(cv::Mat &sx, cv::Mat &sy, cv::Mat &dst, MagnitudeMode mode = MAGNITUDE_EXACT);
+
+// Posterize each channel into the given number of levels (8UC1/3/4, 16UC1/3)
+int quantize(cv::Mat &src, cv::Mat &dst, int levels);
+
+// Copy colors to dst, blacking out pixels on strong luma Sobel edges of edgeSrc
+int darkenEdges(cv::Mat &colors, cv::Mat &edgeSrc, cv::Mat &dst);
+
+// darkenEdges from precomputed 16SC1 luma Sobel X and Y of the same size as colors
+int darkenEdgesGradients(cv::Mat &colors, cv::Mat &sobelX, cv::Mat &sobelY, cv::Mat &dst);
+
+// Cartoon effect combining blur, color quantization, and edge darkening in a single pass
 int blurQuantize(cv::Mat &src, cv::Mat &dst, int levels);
 
 // Detect faces in frame using Haar cascade classifier
 int detectFaces(cv::Mat &frame, std::vector<cv::Rect> &faces);
 
+// Detect faces in an existing 8-bit luma image (input is not modified)
+int detectFacesGray(cv::Mat &gray, std::vector<cv::Rect> &faces);
+
+// Blend sharp and blurred frames per pixel using a depth map (255 = sharp)
+int depthBlend(cv::Mat &src, cv::Mat &blurred, cv::Mat &depth, cv::Mat &dst);
+
 // Portrait mode effect using depth map to selectively blur background
 int depthFocusEffect(cv::Mat &src, cv::Mat &depth, cv::Mat &dst);
 
 // Sketch filter creating pencil drawing effect from edges
 int sketchFilter(cv::Mat &src, cv::Mat &dst);
 
+// Sketch filter computed from a contiguous 8-bit luma plane
+int sketchFromLuma(cv::Mat &luma, cv::Mat &dst);
+
+// Sketch filter from precomputed 16SC1 luma Sobel X and Y
+int sketchFromGradients(cv::Mat &sobelX, cv::Mat &sobelY, cv::Mat &dst);
+
+// 8-bit radial brightness mask around faces, falloff extending expansion pixels past each face
+int spotlightMask(cv::Size size, const std::vector<cv::Rect> &faces, int expansion, cv::Mat &mask);
+
+// Darken src according to an 8-bit spotlight mask
+int applySpotlight(cv::Mat &src, cv::Mat &mask, cv::Mat &dst);
+
 // Spotlight effect darkening surroundings while keeping faces bright
-int spotlightFace(cv::Mat &src, std::vector<cv::Rect> &faces, cv::Mat &dst);
+int spotlightFace(cv::Mat &src, const std::vector<cv::Rect> &faces, cv::Mat &dst);
+
+// Glitch effect simulating analog TV interference with noise and scanlines (seed picks the noise pattern)
+int glitchEffect(cv::Mat &src, cv::Mat &dst, unsigned int seed = 0);
+
+// Gray BGR image from luma stored every pixelStride bytes (1 = planar, 2 = YUYV)
+int lumaToBGR(cv::Mat &plane, int pixelStride, cv::Mat &dst);
 
-// Glitch effect simulating analog TV interference with noise and scanlines
-int glitchEffect(cv::Mat &src, cv::Mat &dst);
+// Glitch effect reading luma every pixelStride bytes, without a color conversion
+int glitchFromLuma(cv::Mat &plane, int pixelStride, cv::Mat &dst, unsigned int seed = 0);
 
 // Color pop effect isolating one color channel (0=blue, 1=green, 2=red)
 int colorPop(cv::Mat &src, cv::Mat &dst, int channelToKeep);
 
 // Spider-Man mask overlay aligned with detected faces
-int spidermanMask(cv::Mat &src, std::vector<cv::Rect> &faces, cv::Mat &dst);
+int spidermanMask(cv::Mat &src, const std::vector<cv::Rect> &faces, cv::Mat &dst);
+
+// Load the face cascade and mask and build the effect caches now instead of on first use (thread-safe)
+int preloadFilterResources();
 
 // Performance testing function comparing blur implementations
 void testBlurTiming(cv::Mat &testImage);
 
+// Speed and error of each magnitude mode against the exact float result
+void testMagnitudeModes(cv::Mat &testImage);
+
+// Cycles, instructions, cache and branch misses per megapixel for each filter (Linux perf events)
+void testFilterCounters(cv::Mat &testImage);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,61 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * filtersV2.h
+ * Allocation-free filter API for the render loop. Every function follows the
+ * same contract:
+ *   - src is read-only (a const view); it only changes when dst is src.
+ *   - dst is caller-owned and reused whenever its size and type already
+ *     match, so steady-state frames allocate nothing.
+ *   - dst may be src; the call then works in place without a copy.
+ *   - roi limits the pixels written (an empty Rect means the whole frame).
+ *     Pixels outside it are copied from src, or left alone when in place,
+ *     and neighbourhood filters still read past the roi edge so the result
+ *     matches a full-frame run.
+ * Returns 0 on success and -1 for unsupported input, like filters.h.
+ */
+
+#ifndef FILTERS_V2_H
+#define FILTERS_V2_H
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+namespace v2 {
+
+// Inverted-red grayscale (8UC1/3/4, 16UC1/3)
+int greyscale(const cv::Mat &src, cv::Mat &dst, cv::Rect roi = cv::Rect());
+
+// Sepia tone (8UC3/4, 16UC3; gray input only for the whole frame since it becomes 3 channels)
+int sepia(const cv::Mat &src, cv::Mat &dst, cv::Rect roi = cv::Rect());
+
+// Separable 5x5 Gaussian blur
+int blur5x5(const cv::Mat &src, cv::Mat &dst, cv::Rect roi = cv::Rect());
+
+// Single-pass cartoon effect
+int blurQuantize(const cv::Mat &src, cv::Mat &dst, int levels, cv::Rect roi = cv::Rect());
+
+// Pencil sketch (BGR in, BGR out)
+int sketch(const cv::Mat &src, cv::Mat &dst, cv::Rect roi = cv::Rect());
+
+// Keep one color channel's strong hues, gray elsewhere
+int colorPop(const cv::Mat &src, cv::Mat &dst, int channelToKeep, cv::Rect roi = cv::Rect());
+
+// Green rectangles around faces; in place this only touches the rectangle outlines
+int drawFaceBoxes(const cv::Mat &src, const std::vector<cv::Rect> &faces, cv::Mat &dst);
+
+// Spotlight around faces (whole frame is darkened, safe in place)
+int spotlightFace(const cv::Mat &src, const std::vector<cv::Rect> &faces, cv::Mat &dst);
+
+// Spider-Man mask; in place only the head rectangles are written
+int spidermanMask(const cv::Mat &src, const std::vector<cv::Rect> &faces, cv::Mat &dst);
+
+// Depth-of-field blend using per-thread scratch buffers for the blurred copy
+int depthFocusEffect(const cv::Mat &src, const cv::Mat &depth, cv::Mat &dst);
+
+} // namespace v2
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * frameRecorder.h
+ * Background encoder thread for snapshots and continuous recording, so JPEG and
+ * video encoding never stall the render loop.
+ */
+
+#ifndef FRAME_RECORDER_H
+#define FRAME_RECORDER_H
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// What to do when the encoder queue is full
+enum BackpressurePolicy {
+    BACKPRESSURE_DROP,     // discard the new frame and count it
+    BACKPRESSURE_BLOCK     // wait on the render thread until a slot frees up
+};
+
+// Owns one encoder thread fed through a bounded queue
+class FrameRecorder {
+private:
+    enum JobType { JOB_SNAPSHOT, JOB_RECORD, JOB_START, JOB_STOP };
+
+    struct Job {
+        JobType type;
+        cv::Mat frame;
+        std::string path;
+        double fps;
+    };
+
+    std::deque<Job> queue;
+    size_t capacity;
+    // Read by getPolicy() on the render thread without the lock
+    std::atomic<BackpressurePolicy> policy;
+    std::mutex lock;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    bool stopping;
+    std::thread worker;
+
+    // Writer state, touched only by the worker thread
+    cv::VideoWriter videoWriter;
+    std::ofstream rawFile;
+    std::string recordPath;
+    double recordFps;
+    cv::Size recordSize;
+    long long clipFrames;
+
+    bool recording;
+
+    std::atomic<long long> snapshotsSaved;
+    std::atomic<long long> framesRecorded;
+    std::atomic<long long> snapshotsDropped;
+    std::atomic<long long> framesDropped;
+
+    bool enqueue(Job &job, bool isFrame);
+    void run();
+    void process(Job &job);
+
+public:
+    FrameRecorder(size_t queueCapacity = 8, BackpressurePolicy policy = BACKPRESSURE_DROP);
+
+    // Calls finish()
+    ~FrameRecorder();
+
+    // Finishes every queued job, closes the recording and joins the thread; later jobs are ignored
+    void finish();
+
+    // Queue a copy of frame to be written as an image; false if it was dropped
+    bool saveSnapshot(const cv::Mat &frame, const std::string &filename);
+
+    // Start continuous recording: *.raw dumps raw pixels, anything else goes through cv::VideoWriter (MJPG)
+    void startRecording(const std::string &path, double fps);
+    void stopRecording();
+    bool isRecording() const { return recording; }
+
+    // Queue a copy of frame for the active recording; false if dropped or not recording
+    bool recordFrame(const cv::Mat &frame);
+
+    void setPolicy(BackpressurePolicy newPolicy);
+    BackpressurePolicy getPolicy() const { return policy; }
+
+    long long getSnapshotsSaved() const { return snapshotsSaved; }
+    long long getFramesRecorded() const { return framesRecorded; }
+    long long getSnapshotsDropped() const { return snapshotsDropped; }
+    long long getFramesDropped() const { return framesDropped; }
+
+    // Prints saved/recorded/dropped counters
+    void printStats() const;
+};
+
+#endif
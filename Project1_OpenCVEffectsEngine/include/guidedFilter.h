@@ -0,0 +1,30 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * guidedFilter.h
+ * Guided filter (He, Sun and Tang) with the color frame as guide. Every output
+ * is a local linear function of the guide colors, fitted over a square window,
+ * so edges in the filtered image land exactly on edges in the frame. All window
+ * sums come from integral images, so the cost per pixel does not depend on the
+ * radius. For depth the coefficients are fitted at low resolution and
+ * upsampled, then applied to the full-resolution frame (fast guided filter).
+ */
+
+#ifndef GUIDED_FILTER_H
+#define GUIDED_FILTER_H
+
+#include <opencv2/opencv.hpp>
+
+// Filter an 8UC1 image guided by a same-size 8UC3 frame; eps is the regularization on 0..1 colors
+int guidedFilter(const cv::Mat &guide, const cv::Mat &src, cv::Mat &dst, int radius, float eps = 0.01f);
+
+// Depth map for portrait mode: estimated and refined at 1/scale, edges taken from the full frame
+int guidedDepth(cv::Mat &src, cv::Mat &depth, int scale = 4);
+
+// Guided depth against the full-resolution 31x31 Gaussian estimate: time and edge sharpness
+void testGuidedDepth(cv::Mat &testImage);
+
+#endif
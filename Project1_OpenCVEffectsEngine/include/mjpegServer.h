@@ -0,0 +1,98 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * mjpegServer.h
+ * Loopback HTTP preview of the processed stream as multipart MJPEG, for
+ * headless runs where no HighGUI window can be opened. The render loop only
+ * copies the frame into a pending buffer; resizing and JPEG encoding happen on
+ * a small encoder pool, and every client has its own sender that always sends
+ * the newest JPEG, so a slow client skips frames instead of slowing anyone down.
+ *
+ * Try it with:
+ *   ./vidDisplay --headless --preview 8080
+ *   curl -s http://127.0.0.1:8080/ --output - | head -c 200
+ * or open http://127.0.0.1:8080/ in a browser.
+ */
+
+#ifndef MJPEG_SERVER_H
+#define MJPEG_SERVER_H
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class MjpegServer {
+private:
+    // One connected viewer and its sender thread
+    struct Client {
+        int fd;
+        std::thread sender;
+        std::atomic<bool> done;
+        long long sent;
+        long long dropped;      // newer JPEGs arrived while this client was still sending
+        Client() : fd(-1), done(false), sent(0), dropped(0) {}
+    };
+
+    int listenFd;
+    int previewWidth;
+    int jpegQuality;
+    std::thread acceptor;
+    std::vector<std::thread> encoders;
+
+    std::mutex lock;
+    std::condition_variable frameWaiting;    // encoders wait for a pending frame
+    std::condition_variable jpegReady;       // senders wait for a newer JPEG
+    bool stopping;
+
+    cv::Mat pending;                         // newest submitted frame, not yet taken by an encoder
+    bool pendingFull;
+    unsigned long long submitted;            // sequence number of the newest submitted frame
+    unsigned long long pendingSeq;
+
+    std::shared_ptr<const std::vector<uchar>> latestJpeg;
+    unsigned long long latestSeq;
+    unsigned long long jpegsPublished;       // JPEGs that became latestJpeg; senders track their gaps
+
+    std::vector<std::unique_ptr<Client>> clients;
+    std::atomic<int> clientCount;
+
+    // Totals
+    long long overwritten;      // submitted frames replaced before any encoder took them
+    long long encoded;
+    double encodeMs;
+    long long clientsServed;
+    long long framesSent;
+    long long framesDropped;
+
+    void acceptLoop();
+    void encodeLoop();
+    void sendLoop(Client *client);
+    void reapClients(bool all);
+
+public:
+    MjpegServer();
+    ~MjpegServer();
+
+    // Listen on 127.0.0.1:port; previewWidth 0 keeps the frame size, quality is 1-100
+    bool start(int port, int previewWidth = 640, int quality = 70, int encoderThreads = 2);
+
+    bool isRunning() const { return listenFd >= 0; }
+
+    // Hand a frame to the encoders without waiting; does nothing while nobody is watching
+    void submit(const cv::Mat &frame);
+
+    // Disconnects every client and joins all threads
+    void stop();
+
+    // Frames encoded, encode time, frames dropped before encoding and per client
+    void printStats() const;
+};
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * overlay.h
+ * Sticker/overlay compositing with premultiplied alpha. Overlays are converted
+ * once, resized copies are cached in size buckets, and compositing is plain
+ * integer math over a rectangle clipped to the frame up front.
+ */
+
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+#include <opencv2/opencv.hpp>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Convert a BGRA or BGR overlay to premultiplied BGRA (CV_8UC4).
+// BGRA pixels with alpha below minAlpha become transparent; BGR pixels whose B+G+R exceeds
+// keyThreshold get keyAlpha, darker pixels are treated as background.
+int premultiplyOverlay(const cv::Mat &src, cv::Mat &dst, int minAlpha = 26, int keyThreshold = 30, int keyAlpha = 230);
+
+// Blend a premultiplied BGRA overlay onto a BGR frame with its top-left corner at topLeft
+int compositeOverlay(cv::Mat &dst, const cv::Mat &overlay, cv::Point topLeft);
+
+// Images keyed by exact size, at most capacity of them; callers do the rounding and the locking
+class SizeCache {
+private:
+    std::map<std::pair<int, int>, cv::Mat> entries;
+    size_t capacity;
+
+public:
+    SizeCache(size_t capacity) : capacity(capacity) {}
+
+    // The image stored for size, or render(size) stored and returned; a full cache is emptied first
+    cv::Mat get(cv::Size size, const std::function<cv::Mat(cv::Size)> &render);
+
+    void clear() { entries.clear(); }
+};
+
+// One overlay image plus resized copies keyed by size bucket, safe to share between threads
+class OverlayCache {
+private:
+    cv::Mat base;           // premultiplied BGRA at the original resolution
+    int bucket;
+    SizeCache scaled;
+    std::mutex lock;
+
+public:
+    // Requested sizes are rounded to a multiple of bucket pixels
+    OverlayCache(int bucket = 8);
+
+    // Load and premultiply an image file (alpha channel kept if present); false if it can't be read
+    bool load(const std::string &path);
+
+    // Use an in-memory overlay; drops previously cached sizes
+    void set(const cv::Mat &image);
+
+    bool empty() const { return base.empty(); }
+
+    // Premultiplied overlay resized to the bucket nearest to size
+    cv::Mat get(cv::Size size);
+
+    // Place the bucketed overlay centered on target and composite it onto dst
+    int draw(cv::Mat &dst, cv::Rect target);
+};
+
+#endif
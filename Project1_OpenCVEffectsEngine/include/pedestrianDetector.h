@@ -0,0 +1,85 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * pedestrianDetector.h
+ * People detection for occupancy counts. The HOG person detector runs only
+ * every few frames, on a downscaled gray pyramid whose levels (and strips of
+ * the larger levels) are scanned in parallel. In between, each person is
+ * followed by template matching in a small search window, which keeps their
+ * id stable across detections.
+ */
+
+#ifndef PEDESTRIAN_DETECTOR_H
+#define PEDESTRIAN_DETECTOR_H
+
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <vector>
+
+// One person being followed, in frame coordinates
+struct TrackedPerson {
+    int id;
+    cv::Rect box;
+    float score;     // HOG margin on detection frames, match score on tracked frames
+};
+
+// Detect-every-N-frames people detector with tracking in between
+class PedestrianDetector {
+private:
+    struct Track {
+        TrackedPerson person;
+        cv::Rect baseBox;      // box in pyramid base coordinates
+        cv::Mat templ;         // base gray patch from the last detection
+    };
+
+    cv::HOGDescriptor hog;
+    int minPersonHeight;
+    int detectInterval;
+    int maxLevels;
+    double levelStep;
+
+    cv::Mat smallColor;              // frame resized to the base scale
+    cv::Mat base;                    // downscaled gray frame
+    std::vector<cv::Mat> pyramid;    // reused level buffers
+    double baseScale;                // base size / frame size
+    std::vector<Track> tracks;
+    int nextId;
+    int framesSinceDetect;
+
+    long long frames;
+    long long detectFrames;
+    long long detectionsFound;
+    long long boxesReported;
+    double totalMs;
+    double detectMs;
+    double trackMs;
+    // First and last process() calls; detections/s is taken over this wall-clock span
+    std::chrono::steady_clock::time_point firstProcess;
+    std::chrono::steady_clock::time_point lastProcess;
+
+    void runDetector(std::vector<cv::Rect> &found, std::vector<double> &weights);
+    void updateTracks(const std::vector<cv::Rect> &found, const std::vector<double> &weights);
+    void followTracks();
+
+public:
+    // minPersonHeight is the smallest person (in frame pixels) worth finding; it sets the base scale
+    PedestrianDetector(int minPersonHeight = 200, int detectInterval = 5, int maxLevels = 5, double levelStep = 1.25);
+
+    // Detect or track people in a BGR frame; returns the number of people
+    int process(cv::Mat &frame, std::vector<TrackedPerson> &people);
+
+    // Run the detector every interval frames (1 = every frame)
+    void setDetectInterval(int interval) { detectInterval = std::max(1, interval); }
+    int getDetectInterval() const { return detectInterval; }
+
+    // Distinct people seen since start
+    int uniqueCount() const { return nextId; }
+
+    // ms/frame, detections/s and the split between detect and track frames
+    void printStats() const;
+};
+
+#endif
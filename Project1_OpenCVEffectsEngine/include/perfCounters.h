@@ -0,0 +1,68 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * perfCounters.h
+ * Hardware performance counters for the benchmark functions, read through
+ * Linux perf_event_open. Cycles, instructions, L1D and last-level cache misses
+ * and branch misses are counted in user space for the calling thread, then
+ * reported per megapixel next to the wall time, so a stage that streams
+ * full-frame temporaries (low IPC, many LLC misses) can be told apart from one
+ * that is bound by arithmetic (high IPC, few misses).
+ *
+ * Counters the kernel or the CPU does not offer (containers, most VMs,
+ * perf_event_paranoid > 2) are shown as n/a and the timings still work.
+ * Only the calling thread is counted, so benchmark single-threaded filters.
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <chrono>
+#include <string>
+
+enum CounterId {
+    COUNTER_CYCLES,
+    COUNTER_INSTRUCTIONS,
+    COUNTER_L1D_MISSES,
+    COUNTER_LLC_MISSES,
+    COUNTER_BRANCH_MISSES,
+    COUNTER_COUNT
+};
+
+// Totals over one start()/stop() interval
+struct CounterReading {
+    double ms = 0;
+    long long values[COUNTER_COUNT] = {0};
+    bool valid[COUNTER_COUNT] = {false};
+};
+
+class PerfCounters {
+private:
+    int fds[COUNTER_COUNT];
+    std::chrono::high_resolution_clock::time_point startTime;
+
+public:
+    // Opens whichever counters are available; none open is not an error
+    PerfCounters();
+    ~PerfCounters();
+
+    // True if at least the cycle counter could be opened
+    bool available() const;
+
+    // Reset and enable every open counter
+    void start();
+
+    // Disable the counters and read them, scaled up if the kernel multiplexed them
+    CounterReading stop();
+
+    // Column headings matching printRow
+    static void printHeader();
+
+    // One row per stage: ms, cycles, instructions, misses per megapixel, and IPC
+    static void printRow(const std::string &name, const CounterReading &reading, double megapixels, int runs);
+};
+
+#endif
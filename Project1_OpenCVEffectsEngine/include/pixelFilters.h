@@ -0,0 +1,66 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * pixelFilters.h
+ * Core per-pixel filters written once over pixel type and channel count.
+ * The templates are explicitly instantiated in pixelFilters.cpp for 8UC1,
+ * 8UC3, 8UC4, 16UC1 and 16UC3, and the public functions in filters.h pick
+ * the instantiation at runtime from Mat::type(), so gray, BGRA and 16-bit
+ * camera frames are processed without a conversion pass.
+ */
+
+#ifndef PIXEL_FILTERS_H
+#define PIXEL_FILTERS_H
+
+#include <opencv2/opencv.hpp>
+
+// Compile-time tag for one supported pixel format
+template <typename T, int Channels>
+struct PixelFormat {
+    typedef T type;
+    static constexpr int channels = Channels;
+};
+
+/*
+ * dispatchPixelFormat - Call fn(PixelFormat<T, C>()) for the Mat type
+ * Returns fn's result, or -1 for types without an instantiation.
+ */
+template <typename Fn>
+int dispatchPixelFormat(int type, Fn fn) {
+    switch (type) {
+        case CV_8UC1:  return fn(PixelFormat<uchar, 1>());
+        case CV_8UC3:  return fn(PixelFormat<uchar, 3>());
+        case CV_8UC4:  return fn(PixelFormat<uchar, 4>());
+        case CV_16UC1: return fn(PixelFormat<ushort, 1>());
+        case CV_16UC3: return fn(PixelFormat<ushort, 3>());
+        default:       return -1;
+    }
+}
+
+namespace pixel {
+
+// 256-entry 8-bit posterize table, cached per thread until levels changes
+const unsigned char *quantizeTable(int levels);
+
+// Inverted red channel (the single channel for gray input) written to every color channel; alpha kept
+template <typename T, int Channels>
+int greyscale(cv::Mat &src, cv::Mat &dst);
+
+// Sepia matrix; gray input is treated as R = G = B and produces 3 channels; alpha kept
+template <typename T, int Channels>
+int sepia(cv::Mat &src, cv::Mat &dst);
+
+// Naive full 5x5 kernel, border pixels copied
+template <typename T, int Channels>
+int blur5x5_1(cv::Mat &src, cv::Mat &dst);
+
+// Posterize every color channel into levels buckets of the type's full range; alpha kept
+template <typename T, int Channels>
+int quantize(cv::Mat &src, cv::Mat &dst, int levels);
+
+} // namespace pixel
+
+#endif
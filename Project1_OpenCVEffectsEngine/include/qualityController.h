@@ -0,0 +1,73 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * qualityController.h
+ * Holds the per-frame processing time under a budget (33 ms for 30 fps) by
+ * stepping through quality levels: processing scale, face/people detection
+ * interval, depth-focus blur passes and dirty-tile skipping. A smoothed frame
+ * time has to stay over budget for a few frames before quality drops, and well
+ * under it for much longer before it comes back, so it does not flicker between
+ * levels; a level that immediately proves too slow makes the next step up wait
+ * twice as long.
+ */
+
+#ifndef QUALITY_CONTROLLER_H
+#define QUALITY_CONTROLLER_H
+
+#include <vector>
+
+// What one quality level allows; level 0 is full quality
+struct QualitySettings {
+    int scale;              // minimum processing scale for depth focus, cartoon and spotlight
+    int detectInterval;     // run face and people detection every this many frames
+    int blurPasses;         // depth-focus background blur passes (0 = the effect's default)
+    bool tileSkip;          // force dirty-tile skipping for the stateless filters
+};
+
+class QualityController {
+private:
+    std::vector<QualitySettings> levels;
+    double budgetMs;
+    bool enabled;
+    int current;
+
+    double smoothedMs;      // exponential moving average of frame time
+    int overFrames;         // consecutive frames with the average over budget
+    int underFrames;        // consecutive frames with the average well under budget
+    int sinceChange;        // frames since the level last changed
+    int upDwell;            // frames of headroom needed before stepping up
+    bool lastStepUp;
+
+    long long frames;
+    long long overBudget;
+    long long stepsDown;
+    long long stepsUp;
+    std::vector<long long> framesAtLevel;
+    double totalMs;
+
+public:
+    QualityController(double budgetMs = 33.0);
+
+    void setEnabled(bool on);
+    bool isEnabled() const { return enabled; }
+    void setBudget(double ms) { budgetMs = ms; }
+    double getBudget() const { return budgetMs; }
+
+    // Feed the processing time of the frame just finished; may change the level
+    void update(double frameMs);
+
+    // Settings to use for the next frame (full quality while disabled)
+    const QualitySettings &settings() const { return levels[enabled ? current : 0]; }
+
+    int level() const { return enabled ? current : 0; }
+    int maxLevel() const { return (int)levels.size() - 1; }
+    double averageMs() const { return smoothedMs; }
+
+    // Frames over budget, steps down/up and time spent at each level
+    void printStats() const;
+};
+
+#endif
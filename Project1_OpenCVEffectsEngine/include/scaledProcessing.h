@@ -0,0 +1,35 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * scaledProcessing.h
+ * Reduced-resolution processing for expensive effects. The heavy stage of an
+ * effect runs at 1/scale resolution and is brought back to full resolution
+ * with joint bilateral upsampling guided by the original frame.
+ */
+
+#ifndef SCALED_PROCESSING_H
+#define SCALED_PROCESSING_H
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+// Edge-aware upsample of an 8-bit 1- or 3-channel image to the size of the BGR guide frame
+int jointBilateralUpsample(cv::Mat &lowRes, cv::Mat &guide, cv::Mat &dst, float sigmaRange = 16.0f);
+
+// Portrait mode with depth estimation and background blur computed at 1/scale resolution
+// (blurPasses 0 keeps the default number of background blur passes; guided fits depth to the frame's edges)
+int depthFocusScaled(cv::Mat &src, cv::Mat &dst, int scale, int blurPasses = 0, bool guided = false);
+
+// Cartoon effect with the blur computed at 1/scale resolution (quantization and edges stay full-res)
+int blurQuantizeScaled(cv::Mat &src, cv::Mat &dst, int levels, int scale);
+
+// Spotlight effect with the falloff mask generated at 1/scale resolution
+int spotlightFaceScaled(cv::Mat &src, std::vector<cv::Rect> &faces, cv::Mat &dst, int scale);
+
+// Reports PSNR against full resolution and speedup of each scaled effect at 1/2 and 1/4
+void testScaleQuality(cv::Mat &testImage);
+
+#endif
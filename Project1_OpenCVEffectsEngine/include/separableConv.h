@@ -0,0 +1,188 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * separableConv.h
+ * Compile-time separable convolution shared by the blur and Sobel filters.
+ * Kernel taps are constexpr arrays so the tap loops unroll, power-of-two
+ * normalizers fold into shifts, and each pixel type / channel count gets
+ * its own specialized code.
+ */
+
+#ifndef SEPARABLE_CONV_H
+#define SEPARABLE_CONV_H
+
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <vector>
+
+// 1D kernel description: taps plus the divisor applied after the pass
+template <int N, int Norm>
+struct ConvKernel {
+    static_assert(N % 2 == 1, "kernel size must be odd");
+    static_assert(Norm > 0, "normalizer must be positive");
+
+    static constexpr int size = N;
+    static constexpr int radius = N / 2;
+    static constexpr int norm = Norm;
+};
+
+// 5-tap Gaussian approximation [1 2 4 2 1] / 16
+struct Gauss5Kernel : ConvKernel<5, 16> {
+    static constexpr std::array<int, 5> taps = {1, 2, 4, 2, 1};
+};
+
+// Sobel smoothing [1 2 1] (unnormalized)
+struct SobelSmoothKernel : ConvKernel<3, 1> {
+    static constexpr std::array<int, 3> taps = {1, 2, 1};
+};
+
+// Sobel derivative [-1 0 1] (unnormalized)
+struct SobelDerivKernel : ConvKernel<3, 1> {
+    static constexpr std::array<int, 3> taps = {-1, 0, 1};
+};
+
+// How pixels the kernel cannot cover are filled
+enum class ConvBorder {
+    Copy,   // pass the source pixel through unchanged
+    Zero    // write zero
+};
+
+namespace conv_detail {
+
+constexpr int log2Exact(int n) {
+    return (n <= 1) ? 0 : 1 + log2Exact(n / 2);
+}
+
+// Divide by the kernel normalizer; power-of-two divisors become shifts
+// (accumulators are non-negative whenever Norm > 1 for smoothing kernels)
+template <int Norm>
+inline int normalize(int v) {
+    if constexpr (Norm == 1) {
+        return v;
+    } else if constexpr ((Norm & (Norm - 1)) == 0) {
+        return v >> log2Exact(Norm);
+    } else {
+        return v / Norm;
+    }
+}
+
+// Horizontal pass for one row into an int accumulator row
+template <typename K, typename Tin, int Channels, ConvBorder Border>
+inline void horizontalPass(const Tin *srcRow, int *accRow, int cols) {
+    constexpr int r = K::radius;
+
+    for (int j = r; j < cols - r; j++) {
+        const Tin *s = srcRow + (j - r) * Channels;
+        int *a = accRow + j * Channels;
+
+        for (int c = 0; c < Channels; c++) {
+            int sum = 0;
+            for (int k = 0; k < K::size; k++) {
+                sum += s[k * Channels + c] * K::taps[k];
+            }
+            a[c] = normalize<K::norm>(sum);
+        }
+    }
+
+    // Columns the kernel cannot cover
+    for (int j = 0; j < r && j < cols; j++) {
+        for (int c = 0; c < Channels; c++) {
+            int left = j * Channels + c;
+            int right = (cols - 1 - j) * Channels + c;
+            if constexpr (Border == ConvBorder::Copy) {
+                accRow[left] = srcRow[left];
+                accRow[right] = srcRow[right];
+            } else {
+                accRow[left] = 0;
+                accRow[right] = 0;
+            }
+        }
+    }
+}
+
+// Fill one output row for rows the vertical kernel cannot cover
+template <typename Tin, typename Tout, int Channels, ConvBorder Border>
+inline void borderRow(const Tin *srcRow, Tout *dstRow, int cols) {
+    for (int j = 0; j < cols * Channels; j++) {
+        dstRow[j] = (Border == ConvBorder::Copy) ? cv::saturate_cast<Tout>(srcRow[j]) : Tout(0);
+    }
+}
+
+} // namespace conv_detail
+
+/*
+ * separableConvolve - Apply Kx horizontally then Ky vertically
+ * Keeps only Ky::size accumulator rows in a ring buffer instead of a full-frame
+ * temporary, so src and dst may be the same Mat (in-place blur is safe).
+ * Returns -1 if src does not match Tin/Channels.
+ */
+template <typename Kx, typename Ky, typename Tin, typename Tout, int Channels,
+          ConvBorder Border = ConvBorder::Copy>
+int separableConvolve(cv::Mat &src, cv::Mat &dst) {
+    static_assert(Channels >= 1 && Channels <= 4, "1 to 4 channels supported");
+
+    if (src.type() != CV_MAKETYPE(cv::traits::Depth<Tin>::value, Channels)) {
+        return -1;
+    }
+
+    const int rows = src.rows;
+    const int cols = src.cols;
+    constexpr int ry = Ky::radius;
+    const int rowLen = cols * Channels;
+
+    dst.create(rows, cols, CV_MAKETYPE(cv::traits::Depth<Tout>::value, Channels));
+
+    // Too small for the kernel: everything is border
+    if (rows < Ky::size || cols < Kx::size) {
+        for (int i = 0; i < rows; i++) {
+            conv_detail::borderRow<Tin, Tout, Channels, Border>(
+                src.ptr<Tin>(i), dst.ptr<Tout>(i), cols);
+        }
+        return 0;
+    }
+
+    // Ring of horizontally filtered rows; row k lives in slot k % Ky::size
+    std::vector<int> ring(Ky::size * rowLen);
+    auto slot = [&](int k) { return ring.data() + (k % Ky::size) * rowLen; };
+
+    for (int k = 0; k < Ky::size - 1; k++) {
+        conv_detail::horizontalPass<Kx, Tin, Channels, Border>(src.ptr<Tin>(k), slot(k), cols);
+    }
+
+    // Top border rows only read their own source row, so writing them first
+    // is safe when src and dst alias
+    for (int i = 0; i < ry; i++) {
+        conv_detail::borderRow<Tin, Tout, Channels, Border>(src.ptr<Tin>(i), dst.ptr<Tout>(i), cols);
+    }
+
+    const int *window[Ky::size];
+    for (int i = ry; i < rows - ry; i++) {
+        // Source row i + ry is consumed before dst row i is written
+        conv_detail::horizontalPass<Kx, Tin, Channels, Border>(
+            src.ptr<Tin>(i + ry), slot(i + ry), cols);
+
+        for (int k = 0; k < Ky::size; k++) {
+            window[k] = slot(i - ry + k);
+        }
+
+        Tout *dstRow = dst.ptr<Tout>(i);
+        for (int j = 0; j < rowLen; j++) {
+            int sum = 0;
+            for (int k = 0; k < Ky::size; k++) {
+                sum += window[k][j] * Ky::taps[k];
+            }
+            dstRow[j] = cv::saturate_cast<Tout>(conv_detail::normalize<Ky::norm>(sum));
+        }
+    }
+
+    for (int i = rows - ry; i < rows; i++) {
+        conv_detail::borderRow<Tin, Tout, Channels, Border>(src.ptr<Tin>(i), dst.ptr<Tout>(i), cols);
+    }
+
+    return 0;
+}
+
+#endif
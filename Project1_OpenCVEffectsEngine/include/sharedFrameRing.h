@@ -0,0 +1,116 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * sharedFrameRing.h
+ * Hands processed frames to other processes through a POSIX shared-memory ring.
+ * The writer copies each frame into the next slot and never waits for anyone;
+ * readers map the segment read-only and look at frames in place. Every slot is
+ * guarded by a seqlock: its sequence is odd while the writer fills it, so a
+ * reader that sees the same even sequence before and after using a frame knows
+ * the frame was not overwritten underneath it. A slow reader simply skips ahead.
+ *
+ * Layout: one RingHeader, then slotCount slots of slotStride bytes, each a
+ * SlotHeader followed by the pixel rows (step = cols * elemSize, no padding).
+ */
+
+#ifndef SHARED_FRAME_RING_H
+#define SHARED_FRAME_RING_H
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Identifies a mapped segment as a frame ring of this layout
+static const uint32_t frameRingMagic = 0x46524e47;   // "FRNG"
+static const uint32_t frameRingVersion = 1;
+
+// Segment start; written once by the creator except for writeCount
+struct RingHeader {
+    std::atomic<uint32_t> magic;        // stored last with release; readers acquire it before the rest
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t headerBytes;               // offset of slot 0
+    uint64_t slotStride;                // bytes from one slot to the next
+    uint64_t slotCapacity;              // largest frame payload a slot holds
+    std::atomic<uint64_t> writeCount;   // frames published so far; frame n lives in slot n % slotCount
+};
+
+// Per-slot header; the frame pixels follow it
+struct alignas(64) SlotHeader {
+    std::atomic<uint64_t> sequence;     // 2n + 1 while frame n is written, 2n + 2 once it is complete
+    uint64_t frameNumber;
+    int64_t timestampNs;                // steady clock at publish time
+    int32_t rows;
+    int32_t cols;
+    int32_t type;                       // OpenCV type, e.g. CV_8UC3
+    uint32_t step;
+    uint64_t size;                      // payload bytes
+};
+
+// A frame viewed in place; image points into shared memory and must be checked with stillValid()
+struct RingFrame {
+    cv::Mat image;
+    uint64_t frameNumber = 0;
+    int64_t timestampNs = 0;
+    uint64_t sequence = 0;
+    const SlotHeader *slot = nullptr;
+};
+
+// Single-writer, many-reader frame ring in POSIX shared memory (Linux only)
+class SharedFrameRing {
+private:
+    std::string segmentName;
+    bool owner;
+    unsigned char *base;
+    size_t mappedBytes;
+    RingHeader *header;
+    uint64_t nextFrame;     // reader: next frame number next() wants
+
+    // Publish counters (writer side)
+    long long published;
+    long long oversized;
+    // Read counters (reader side)
+    long long delivered;
+    long long skipped;
+    long long torn;
+
+    SlotHeader *slotAt(uint64_t frameNumber) const;
+    bool viewSlot(uint64_t frameNumber, RingFrame &frame);
+
+public:
+    SharedFrameRing();
+    ~SharedFrameRing();
+
+    // Writer: create (or replace) the segment with slotCount slots of up to slotCapacity bytes
+    bool create(const std::string &name, int slotCount, size_t slotCapacity);
+
+    // Reader: map an existing segment read-only
+    bool open(const std::string &name);
+
+    bool isOpened() const { return header != nullptr; }
+    int slotCount() const { return header ? (int)header->slotCount : 0; }
+
+    // Writer: copy a continuous or strided frame into the next slot; never blocks on readers
+    int publish(const cv::Mat &frame);
+
+    // Reader: newest complete frame; false if none is readable yet
+    bool latest(RingFrame &frame);
+
+    // Reader: the frame after the last one returned, jumping to the oldest still in the ring if overrun
+    bool next(RingFrame &frame);
+
+    // Reader: true if the writer has not started overwriting the frame since it was returned
+    bool stillValid(const RingFrame &frame) const;
+
+    // Unmaps; the creator also unlinks the segment name
+    void close();
+
+    // Frames published/dropped (writer) or delivered/skipped/torn (reader)
+    void printStats() const;
+};
+
+#endif
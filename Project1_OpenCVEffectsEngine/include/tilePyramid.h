@@ -0,0 +1,101 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * tilePyramid.h
+ * Multi-resolution tile pyramid for images too large to hold decoded. A
+ * one-time build decodes the source, cuts every level (each half the size of
+ * the one below) into square tiles and stores them JPEG-compressed in a cache
+ * file. Viewing reads only the index, then decodes the tiles the window
+ * touches into an LRU cache of fixed capacity, so memory depends on the window
+ * size and not on the image size.
+ *
+ * Cache file layout (native byte order):
+ *   header: "TPYR", version, tile size, level count, source bytes, source mtime
+ *   per level: width, height
+ *   per tile, level 0 first, rows top to bottom: data offset, data length
+ *   JPEG data of every tile
+ */
+
+#ifndef TILE_PYRAMID_H
+#define TILE_PYRAMID_H
+
+#include <opencv2/opencv.hpp>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TilePyramid {
+private:
+    struct Level {
+        int width;
+        int height;
+        int tilesX;
+        int tilesY;
+        size_t firstTile;       // index entry of the level's top-left tile
+    };
+
+    struct TileEntry {
+        unsigned long long offset;
+        unsigned int length;
+    };
+
+    typedef std::pair<unsigned long long, cv::Mat> CachedTile;
+
+    std::ifstream file;
+    int tileSize;
+    std::vector<Level> levels;
+    std::vector<TileEntry> index;
+
+    // Decoded tiles, most recently used at the front
+    size_t maxTiles;
+    std::list<CachedTile> lru;
+    std::unordered_map<unsigned long long, std::list<CachedTile>::iterator> lookup;
+    size_t residentBytes;
+
+    long long tilesDecoded;
+    long long cacheHits;
+    long long bytesRead;
+    size_t peakBytes;
+
+    static int build(const std::string &imagePath, const std::string &cachePath, int tileSize,
+                     long long sourceBytes, long long sourceTime);
+    int loadIndex(const std::string &cachePath, int tileSize, long long sourceBytes, long long sourceTime);
+
+public:
+    TilePyramid(size_t maxTiles = 160);
+
+    // Open the pyramid of imagePath from cachePath, building the cache first if it is missing or stale
+    int open(const std::string &imagePath, const std::string &cachePath, int tileSize = 256);
+
+    int levelCount() const { return (int)levels.size(); }
+    cv::Size levelSize(int level) const { return cv::Size(levels[level].width, levels[level].height); }
+    int getTileSize() const { return tileSize; }
+
+    // Decoded 8UC3 tile (tx, ty) of a level; tiles on the right and bottom edges are smaller
+    int tile(int level, int tx, int ty, cv::Mat &dst);
+
+    // Pixels of a rectangle of one level, assembled from the tiles it overlaps
+    int region(int level, const cv::Rect &rect, cv::Mat &dst);
+
+    // Window of viewport size centred on (centerX, centerY) in full-resolution pixels, zoom being
+    // window pixels per full-resolution pixel. Reads from the coarsest level that still has a
+    // pixel for every window pixel; filter (8UC3 in and out) sees only the visible part of that
+    // level plus halo pixels. Returns the level used.
+    int render(double centerX, double centerY, double zoom, cv::Size viewport,
+               const std::function<int(cv::Mat &, cv::Mat &)> &filter, int halo, cv::Mat &dst);
+
+    // Decoded tiles held, and their total size
+    size_t residentTiles() const { return lru.size(); }
+    size_t residentMemory() const { return residentBytes; }
+
+    // Tiles decoded, cache hits and peak decoded memory
+    void printStats() const;
+};
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * v4l2Capture.h
+ * Zero-copy Linux V4L2 capture. Frames are dequeued from mmap'd driver buffers
+ * and exposed as cv::Mat views in their native YUYV or NV12 layout, so luma-only
+ * effects can read Y without a BGR conversion or an extra copy.
+ *
+ * Without a camera, either of these should stand in for one. Both need root and
+ * the kernel module, so nothing in this project runs them automatically:
+ *   sudo modprobe vivid                 (virtual capture device with test patterns)
+ *   ./vidDisplay --v4l2 /dev/video0 yuyv
+ * or feed recorded footage through v4l2loopback:
+ *   sudo modprobe v4l2loopback video_nr=10
+ *   ffmpeg -re -i clip.mp4 -f v4l2 -pix_fmt yuyv422 /dev/video10
+ *   ./vidDisplay --v4l2 /dev/video10 yuyv
+ */
+
+#ifndef V4L2_CAPTURE_H
+#define V4L2_CAPTURE_H
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+
+enum FramePixelFormat {
+    PIXFMT_YUYV,    // packed Y0 U Y1 V, 2 bytes per pixel
+    PIXFMT_NV12     // Y plane followed by interleaved half-resolution UV plane
+};
+
+// One dequeued frame; the Mats point into the driver buffer and stay valid until release()
+struct V4L2Frame {
+    FramePixelFormat format = PIXFMT_YUYV;
+    cv::Mat raw;            // YUYV: rows x cols CV_8UC2; NV12: rows*3/2 x cols CV_8UC1
+    cv::Mat luma;           // NV12: rows x cols CV_8UC1 view of the Y plane; YUYV: empty
+    int index = -1;         // driver buffer index
+    unsigned int sequence = 0;
+};
+
+// Memory-mapped streaming capture from a V4L2 device (Linux only)
+class V4L2Capture {
+private:
+    struct MappedBuffer {
+        void *start;
+        size_t length;
+    };
+
+    int fd;
+    int frameWidth;
+    int frameHeight;
+    int bytesPerLine;
+    FramePixelFormat pixelFormat;
+    std::vector<MappedBuffer> buffers;
+
+public:
+    V4L2Capture();
+    ~V4L2Capture();
+
+    // Opens the device, negotiates the format and starts streaming with bufferCount mmap buffers
+    bool open(const std::string &device, int width, int height, FramePixelFormat format, int bufferCount = 4);
+
+    bool isOpened() const { return fd >= 0; }
+    int width() const { return frameWidth; }
+    int height() const { return frameHeight; }
+
+    // Blocks until the driver fills a buffer and wraps it without copying
+    bool grab(V4L2Frame &frame);
+
+    // Hands the buffer back to the driver; frame views become invalid
+    void release(V4L2Frame &frame);
+
+    // Stops streaming, unmaps buffers and closes the device
+    void close();
+};
+
+// Convert a captured frame to BGR (the only conversion chroma-using effects need)
+int frameToBGR(V4L2Frame &frame, cv::Mat &dst);
+
+// Luma bytes straight from the driver buffer: plane rows hold Y every pixelStride bytes
+int frameLumaView(V4L2Frame &frame, cv::Mat &plane, int &pixelStride);
+
+// Contiguous 8-bit luma image; zero-copy for NV12, one Y extraction pass for YUYV
+int frameLuma(V4L2Frame &frame, cv::Mat &gray);
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * workStealingPool.h
+ * Thread pool with one task deque per worker. A worker takes its newest
+ * task first (cache-warm) and, when its own deque is empty, steals the oldest
+ * task from another worker, so uneven task sizes even out without a single
+ * contended queue.
+ */
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+private:
+    struct Queue {
+        std::deque<std::function<void()>> tasks;
+        std::mutex lock;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    // Sleeping workers wait here until queued is non-zero
+    std::mutex idleLock;
+    std::condition_variable idle;
+    std::atomic<int> queued;
+    bool stopping;
+
+    std::atomic<unsigned int> nextQueue;
+    std::atomic<long long> executed;
+    std::atomic<long long> stolen;
+
+    bool takeTask(int self, std::function<void()> &task);
+    void run(int self);
+
+public:
+    // threadCount = 0 uses every hardware thread
+    WorkStealingPool(int threadCount = 0);
+
+    // Runs every queued task, then joins the workers
+    ~WorkStealingPool();
+
+    // Queue a task; from a worker it goes to that worker's deque, otherwise the deques take turns
+    void submit(std::function<void()> task);
+
+    int size() const { return (int)workers.size(); }
+    long long tasksExecuted() const { return executed; }
+    long long tasksStolen() const { return stolen; }
+};
+
+#endif
@@ -0,0 +1,321 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * autoTuner.cpp
+ * Variant timing, winner selection, the cache file and the standard variants.
+ */
+
+#include "autoTuner.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include "filters.h"
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+static double median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0;
+    }
+    size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    return values[middle];
+}
+
+// e.g. 8UC3
+static std::string typeName(int type) {
+    static const char *depths[] = {"8U", "8S", "16U", "16S", "32S", "32F", "64F", "16F"};
+    return std::string(depths[CV_MAT_DEPTH(type)]) + "C" + std::to_string(CV_MAT_CN(type));
+}
+
+static std::string choiceKey(const std::string &filter, int width, int height, int type, int threads) {
+    std::ostringstream key;
+    key << filter << ' ' << width << ' ' << height << ' ' << type << ' ' << threads;
+    return key.str();
+}
+
+AutoTuner::AutoTuner(const std::string &cachePath, int samplesPerVariant)
+    : cachePath(cachePath), samplesPerVariant(std::max(1, samplesPerVariant)) {
+    loadCache();
+}
+
+void AutoTuner::registerVariant(const std::string &filter, const std::string &name, KernelFn fn) {
+    variants[filter].push_back({name, fn});
+}
+
+bool AutoTuner::setOverride(const std::string &filter, const std::string &name) {
+    if (variantIndex(filter, name) < 0) {
+        std::cout << "Error: no variant " << name << " of " << filter << std::endl;
+        return false;
+    }
+    overrides[filter] = name;
+    return true;
+}
+
+int AutoTuner::variantIndex(const std::string &filter, const std::string &name) const {
+    auto found = variants.find(filter);
+    if (found == variants.end()) {
+        return -1;
+    }
+    for (size_t v = 0; v < found->second.size(); v++) {
+        if (found->second[v].name == name) {
+            return (int)v;
+        }
+    }
+    return -1;
+}
+
+/*
+ * choiceFor - The tuning entry for this filter at src's size and type and the current thread count
+ * A cached winner that is no longer registered is tuned again.
+ */
+AutoTuner::Choice &AutoTuner::choiceFor(const std::string &filter, const cv::Mat &src) {
+    int threads = cv::getNumThreads();
+    Choice &choice = choices[choiceKey(filter, src.cols, src.rows, src.type(), threads)];
+    if (choice.filter.empty()) {
+        choice.filter = filter;
+        choice.size = src.size();
+        choice.type = src.type();
+        choice.threads = threads;
+    }
+    if (choice.source == TUNE_CACHE && variantIndex(filter, choice.winner) < 0) {
+        choice.source = TUNE_PENDING;
+    }
+    if (choice.samples.size() != variants[filter].size()) {
+        choice.samples.assign(variants[filter].size(), std::vector<double>());
+        choice.runs = 0;
+    }
+    return choice;
+}
+
+/*
+ * decide - Pick the variant with the lowest median time
+ * Medians rather than means, so one frame that lost its core to another process does not
+ * decide the outcome.
+ */
+void AutoTuner::decide(Choice &choice, TuneSource source) {
+    const std::vector<Variant> &list = variants[choice.filter];
+    choice.medians.assign(list.size(), 0.0);
+    int best = 0;
+    for (size_t v = 0; v < list.size(); v++) {
+        choice.medians[v] = median(choice.samples[v]);
+        if (choice.medians[v] < choice.medians[best]) {
+            best = (int)v;
+        }
+    }
+    choice.winner = list[best].name;
+    choice.winnerMs = choice.medians[best];
+    choice.source = source;
+}
+
+/*
+ * run - Dispatch to the chosen variant, or keep tuning
+ * While tuning, every call runs the next variant in turn, so the output stays correct and each
+ * variant sees the same kind of frames. The first round only warms caches and is not counted.
+ */
+int AutoTuner::run(const std::string &filter, cv::Mat &src, cv::Mat &dst) {
+    auto found = variants.find(filter);
+    if (found == variants.end() || found->second.empty() || src.empty()) {
+        return -1;
+    }
+    std::vector<Variant> &list = found->second;
+
+    auto forced = overrides.find(filter);
+    if (forced != overrides.end()) {
+        return list[variantIndex(filter, forced->second)].fn(src, dst);
+    }
+
+    Choice &choice = choiceFor(filter, src);
+    if (choice.source != TUNE_PENDING) {
+        return list[variantIndex(filter, choice.winner)].fn(src, dst);
+    }
+
+    int v = choice.runs % (int)list.size();
+    choice.runs++;
+    auto start = std::chrono::high_resolution_clock::now();
+    int result = list[v].fn(src, dst);
+    double ms = elapsedMs(start);
+    if (choice.runs > (int)list.size()) {
+        choice.samples[v].push_back(ms);
+    }
+
+    if (choice.runs >= (int)list.size() * (samplesPerVariant + 1)) {
+        decide(choice, TUNE_ONLINE);
+        std::cout << "Auto-tuner: " << filter << " at " << src.cols << "x" << src.rows << " uses "
+                  << choice.winner << " (" << choice.winnerMs << " ms)" << std::endl;
+        saveCache();
+    }
+    return result;
+}
+
+void AutoTuner::calibrate(cv::Mat &src, int repetitions) {
+    cv::Mat dst;
+    for (auto &entry : variants) {
+        Choice &choice = choiceFor(entry.first, src);
+        for (size_t v = 0; v < entry.second.size(); v++) {
+            choice.samples[v].clear();
+            entry.second[v].fn(src, dst);
+            for (int r = 0; r < repetitions; r++) {
+                auto start = std::chrono::high_resolution_clock::now();
+                entry.second[v].fn(src, dst);
+                choice.samples[v].push_back(elapsedMs(start));
+            }
+        }
+        decide(choice, TUNE_CALIBRATED);
+    }
+    saveCache();
+}
+
+void AutoTuner::loadCache() {
+    if (cachePath.empty()) {
+        return;
+    }
+    std::ifstream file(cachePath);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        Choice choice;
+        int width, height;
+        if (!(fields >> choice.filter >> width >> height >> choice.type >> choice.threads >>
+              choice.winner >> choice.winnerMs)) {
+            continue;
+        }
+        choice.size = cv::Size(width, height);
+        choice.source = TUNE_CACHE;
+        choices[choiceKey(choice.filter, width, height, choice.type, choice.threads)] = choice;
+    }
+}
+
+void AutoTuner::saveCache() const {
+    if (cachePath.empty()) {
+        return;
+    }
+    std::ofstream file(cachePath);
+    if (!file) {
+        std::cout << "Error: cannot write tuning cache " << cachePath << std::endl;
+        return;
+    }
+    file << "# filter width height type threads variant median_ms" << std::endl;
+    for (auto &entry : choices) {
+        const Choice &choice = entry.second;
+        if (choice.source == TUNE_PENDING) {
+            continue;
+        }
+        file << choice.filter << ' ' << choice.size.width << ' ' << choice.size.height << ' ' << choice.type << ' '
+             << choice.threads << ' ' << choice.winner << ' ' << choice.winnerMs << std::endl;
+    }
+}
+
+void AutoTuner::printReport() const {
+    std::cout << "\n=== Kernel auto-tuner ===" << std::endl;
+    for (auto &forced : overrides) {
+        std::cout << forced.first << ": " << forced.second << " (forced on the command line)" << std::endl;
+    }
+
+    for (auto &entry : choices) {
+        const Choice &choice = entry.second;
+        if (overrides.count(choice.filter)) {
+            continue;
+        }
+        std::cout << choice.filter << " " << choice.size.width << "x" << choice.size.height << " "
+                  << typeName(choice.type) << ", " << choice.threads << " threads: ";
+
+        if (choice.source == TUNE_PENDING) {
+            std::cout << "still tuning (" << choice.runs << " frames so far)" << std::endl;
+            continue;
+        }
+        std::cout << choice.winner << " at " << choice.winnerMs << " ms";
+        if (choice.source == TUNE_CACHE) {
+            std::cout << " (from " << cachePath << ")" << std::endl;
+            continue;
+        }
+        std::cout << (choice.source == TUNE_ONLINE ? " (timed on the first frames)" : " (calibrated)") << std::endl;
+
+        // The medians that decided it, and how much slower each loser is
+        auto found = variants.find(choice.filter);
+        for (size_t v = 0; found != variants.end() && v < found->second.size() && v < choice.medians.size(); v++) {
+            std::cout << "  " << found->second[v].name << ": " << choice.medians[v] << " ms";
+            if (choice.winnerMs > 0 && found->second[v].name != choice.winner) {
+                std::cout << " (" << choice.medians[v] / choice.winnerMs << "x)";
+            }
+            std::cout << std::endl;
+        }
+    }
+}
+
+/*
+ * bandParallel - Run fn on horizontal bands of the frame at once
+ * Each band reads halo extra rows on both sides into a per-thread scratch image and copies only
+ * its own rows out, so the bands never write each other's pixels.
+ */
+KernelFn bandParallel(KernelFn fn, int halo) {
+    return [fn, halo](cv::Mat &src, cv::Mat &dst) {
+        int bands = std::min(cv::getNumThreads() * 2, src.rows / std::max(8, 4 * halo));
+        if (bands < 2 || dst.data == src.data) {
+            return fn(src, dst);
+        }
+
+        dst.create(src.rows, src.cols, src.type());
+        std::vector<int> results(bands, 0);
+        cv::parallel_for_(cv::Range(0, bands), [&](const cv::Range &range) {
+            thread_local cv::Mat scratch;
+            for (int b = range.start; b < range.end; b++) {
+                int y0 = src.rows * b / bands;
+                int y1 = src.rows * (b + 1) / bands;
+                int r0 = std::max(0, y0 - halo);
+                int r1 = std::min(src.rows, y1 + halo);
+                // Bands differ in height by a row or two; a view of one tall buffer avoids reallocating
+                if (scratch.rows < r1 - r0 || scratch.cols != src.cols || scratch.type() != src.type()) {
+                    scratch.create(src.rows / bands + 2 + 2 * halo, src.cols, src.type());
+                }
+                cv::Mat in = src.rowRange(r0, r1);
+                cv::Mat out = scratch.rowRange(0, r1 - r0);
+                results[b] = fn(in, out);
+                if (results[b] == 0) {
+                    out.rowRange(y0 - r0, y1 - r0).copyTo(dst.rowRange(y0, y1));
+                }
+            }
+        });
+
+        for (int b = 0; b < bands; b++) {
+            if (results[b] != 0) {
+                return results[b];
+            }
+        }
+        return 0;
+    };
+}
+
+/*
+ * registerStandardVariants - One entry per distinct implementation
+ * The v2 wrappers forward full frames to these same kernels, so they are not listed separately.
+ * The naive blur is left out because it copies its 2-pixel border instead of filtering it:
+ * switching to it while tuning makes the frame edge flicker. testBlurTiming still times it.
+ */
+void registerStandardVariants(AutoTuner &tuner) {
+    tuner.registerVariant("grey", "serial", [](cv::Mat &src, cv::Mat &dst) { return greyscale(src, dst); });
+    tuner.registerVariant("grey", "bands", bandParallel([](cv::Mat &src, cv::Mat &dst) {
+        return greyscale(src, dst);
+    }, 0));
+
+    tuner.registerVariant("sepia", "serial", [](cv::Mat &src, cv::Mat &dst) { return sepia(src, dst); });
+    tuner.registerVariant("sepia", "bands", bandParallel([](cv::Mat &src, cv::Mat &dst) {
+        return sepia(src, dst);
+    }, 0));
+
+    tuner.registerVariant("blur", "separable", [](cv::Mat &src, cv::Mat &dst) { return blur5x5_2(src, dst); });
+    tuner.registerVariant("blur", "bands", bandParallel([](cv::Mat &src, cv::Mat &dst) {
+        return blur5x5_2(src, dst);
+    }, 2));
+}
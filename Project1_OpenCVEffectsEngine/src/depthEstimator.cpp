@@ -14,12 +14,22 @@
  * estimateDepth - Custom depth estimation from single image
  * Combines brightness inversion, contrast enhancement, smoothing, and center-weighted bias to approximate depth.
  */
-int estimateDepth(cv::Mat &src, cv::Mat &dst) {
+int estimateDepth(cv::Mat &src, cv::Mat &dst, int blurSize) {
 
     cv::Mat gray;
     cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
+    return estimateDepthGray(gray, dst, blurSize);
+}
 
-    dst.create(src.rows, src.cols, CV_8UC1);
+/*
+ * estimateDepthGray - Depth estimation from an existing 8-bit luma image
+ */
+int estimateDepthGray(cv::Mat &gray, cv::Mat &dst, int blurSize) {
+    if (gray.type() != CV_8UC1) {
+        return -1;
+    }
+
+    dst.create(gray.rows, gray.cols, CV_8UC1);
 
     // Invert brightness and enhance contrast
     for (int i = 0; i < gray.rows; i++) {
@@ -38,7 +48,7 @@ int estimateDepth(cv::Mat &src, cv::Mat &dst) {
     }
 
     // Smooth depth map with large Gaussian kernel
-    cv::GaussianBlur(dst, dst, cv::Size(31, 31), 0);
+    cv::GaussianBlur(dst, dst, cv::Size(blurSize, blurSize), 0);
 
     // Apply center-weighted bias assuming subject is centered
     int centerX = dst.cols / 2;
@@ -0,0 +1,172 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * dirtyTiles.cpp
+ * Tile change detection and tiled re-rendering of stateless spatial filters.
+ */
+
+#include "dirtyTiles.h"
+#include <iostream>
+
+// Luma is sampled on a 4x4 grid, 1/16 of the pixels
+static const int SAMPLE_STEP = 4;
+
+DirtyTileTracker::DirtyTileTracker(int tileSize, int threshold)
+    : tileSize(((std::max(tileSize, SAMPLE_STEP) + SAMPLE_STEP - 1) / SAMPLE_STEP) * SAMPLE_STEP),
+      threshold(threshold), tilesX(0), tilesY(0), forceAll(true), dirtyCount(0),
+      tilesSeen(0), tilesSkipped(0) {}
+
+/*
+ * update - Detect which tiles changed since they were last rendered
+ * Comparing against the per-tile reference rather than the previous frame means slow drift
+ * still triggers a refresh once it adds up past the threshold.
+ */
+int DirtyTileTracker::update(cv::Mat &frame) {
+    if (frame.size() != frameSize) {
+        frameSize = frame.size();
+        tilesX = (frame.cols + tileSize - 1) / tileSize;
+        tilesY = (frame.rows + tileSize - 1) / tileSize;
+        forceAll = true;
+    }
+
+    int sampleCols = (frame.cols + SAMPLE_STEP - 1) / SAMPLE_STEP;
+    int sampleRows = (frame.rows + SAMPLE_STEP - 1) / SAMPLE_STEP;
+    current.create(sampleRows, sampleCols, CV_8UC1);
+
+    int channels = frame.channels();
+    for (int si = 0; si < sampleRows; si++) {
+        unsigned char *srcRow = frame.ptr<unsigned char>(si * SAMPLE_STEP);
+        unsigned char *curRow = current.ptr<unsigned char>(si);
+
+        for (int sj = 0; sj < sampleCols; sj++) {
+            unsigned char *p = srcRow + sj * SAMPLE_STEP * channels;
+            // (B + 2G + R) / 4 is close enough to luma for change detection
+            curRow[sj] = (channels >= 3) ? (unsigned char)((p[0] + 2 * p[1] + p[2]) >> 2) : p[0];
+        }
+    }
+
+    int samplesPerTile = tileSize / SAMPLE_STEP;
+    dirty.assign(tilesX * tilesY, 0);
+
+    if (forceAll) {
+        current.copyTo(reference);
+        std::fill(dirty.begin(), dirty.end(), 1);
+        dirtyCount = tilesX * tilesY;
+        forceAll = false;
+    } else {
+        dirtyCount = 0;
+        for (int ty = 0; ty < tilesY; ty++) {
+            int r0 = ty * samplesPerTile;
+            int r1 = std::min(r0 + samplesPerTile, sampleRows);
+
+            for (int tx = 0; tx < tilesX; tx++) {
+                int c0 = tx * samplesPerTile;
+                int c1 = std::min(c0 + samplesPerTile, sampleCols);
+
+                int sad = 0;
+                for (int si = r0; si < r1; si++) {
+                    unsigned char *curRow = current.ptr<unsigned char>(si);
+                    unsigned char *refRow = reference.ptr<unsigned char>(si);
+                    for (int sj = c0; sj < c1; sj++) {
+                        sad += std::abs(curRow[sj] - refRow[sj]);
+                    }
+                }
+
+                bool forced = false;
+                cv::Rect tileRect(tx * tileSize, ty * tileSize, tileSize, tileSize);
+                for (size_t r = 0; r < pendingRects.size() && !forced; r++) {
+                    forced = (tileRect & pendingRects[r]).area() > 0;
+                }
+
+                if (forced || sad > threshold * (r1 - r0) * (c1 - c0)) {
+                    dirty[ty * tilesX + tx] = 1;
+                    dirtyCount++;
+
+                    // This tile will be re-rendered from the current frame
+                    for (int si = r0; si < r1; si++) {
+                        unsigned char *curRow = current.ptr<unsigned char>(si);
+                        unsigned char *refRow = reference.ptr<unsigned char>(si);
+                        for (int sj = c0; sj < c1; sj++) {
+                            refRow[sj] = curRow[sj];
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    pendingRects.clear();
+
+    tilesSeen += tilesX * tilesY;
+    tilesSkipped += tilesX * tilesY - dirtyCount;
+
+    return dirtyCount;
+}
+
+double DirtyTileTracker::lastSkippedPercent() const {
+    int total = tilesX * tilesY;
+    return total > 0 ? 100.0 * (total - dirtyCount) / total : 0.0;
+}
+
+double DirtyTileTracker::totalSkippedPercent() const {
+    return tilesSeen > 0 ? 100.0 * tilesSkipped / tilesSeen : 0.0;
+}
+
+void DirtyTileTracker::printStats() const {
+    std::cout << "Tiles skipped: " << tilesSkipped << " / " << tilesSeen
+              << " (" << totalSkippedPercent() << "%)" << std::endl;
+}
+
+/*
+ * applyTiled - Re-render only the dirty tiles of a stateless filter
+ * Consecutive dirty tiles in a row are merged into one ROI to keep per-call overhead low.
+ * Changed pixels also affect neighbours up to halo pixels away, so the tile run grown by halo
+ * is written back, computed from an ROI grown by halo once more so every written pixel sees
+ * the same neighbourhood as on the full frame.
+ */
+int applyTiled(std::function<int(cv::Mat &, cv::Mat &)> filter, cv::Mat &src, cv::Mat &dst,
+               DirtyTileTracker &tracker, int halo) {
+    // Nothing cached to reuse, or nothing worth reusing
+    if (dst.size() != src.size() || tracker.allDirty()) {
+        return filter(src, dst);
+    }
+
+    cv::Rect bounds(0, 0, src.cols, src.rows);
+    int tileSize = tracker.getTileSize();
+
+    for (int ty = 0; ty < tracker.getTilesY(); ty++) {
+        int tx = 0;
+        while (tx < tracker.getTilesX()) {
+            if (!tracker.isDirty(tx, ty)) {
+                tx++;
+                continue;
+            }
+
+            int runStart = tx;
+            while (tx < tracker.getTilesX() && tracker.isDirty(tx, ty)) {
+                tx++;
+            }
+
+            cv::Rect tileRect(runStart * tileSize, ty * tileSize, (tx - runStart) * tileSize, tileSize);
+            cv::Rect writeRect = cv::Rect(tileRect.x - halo, tileRect.y - halo,
+                                          tileRect.width + 2 * halo, tileRect.height + 2 * halo) & bounds;
+            cv::Rect readRect = cv::Rect(writeRect.x - halo, writeRect.y - halo,
+                                         writeRect.width + 2 * halo, writeRect.height + 2 * halo) & bounds;
+
+            cv::Mat srcRoi = src(readRect);
+            cv::Mat out;
+            if (filter(srcRoi, out) != 0) {
+                return -1;
+            }
+
+            cv::Rect inner(writeRect.x - readRect.x, writeRect.y - readRect.y, writeRect.width, writeRect.height);
+            cv::Mat dstRoi = dst(writeRect);
+            out(inner).copyTo(dstRoi);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,287 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * effectsMosaic.cpp
+ * All-effects grid with shared per-frame intermediates and a persistent worker pool.
+ */
+
+#include "effectsMosaic.h"
+#include "filters.h"
+#include "filtersV2.h"
+#include "depthEstimator.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+EffectsMosaic::EffectsMosaic(int columns, int workerCount)
+    : columns(columns), generation(0), stopping(false), seed(0), cartoonLevels(10),
+      framesRendered(0), totalFrameMs(0), totalSharedMs(0), lastMs(0) {
+    addEffects();
+    tiles.resize(effects.size());
+
+    if (this->columns <= 0) {
+        this->columns = (int)std::ceil(std::sqrt((double)effects.size()));
+    }
+
+    if (workerCount <= 0) {
+        workerCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    // The rendering thread takes tasks too, so it counts as one of the workers
+    for (int i = 1; i < workerCount; i++) {
+        workers.emplace_back(&EffectsMosaic::run, this);
+    }
+}
+
+EffectsMosaic::~EffectsMosaic() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+/*
+ * addEffects - Register every tile, each reading only the shared tile-size inputs
+ * Every tile writes its own output Mat, so the tiles can run in any order on any thread.
+ */
+void EffectsMosaic::addEffects() {
+    effects.push_back({"Color", [this](cv::Mat &out) {
+        small.copyTo(out);
+        return 0;
+    }, 0});
+    effects.push_back({"Gray (OpenCV)", [this](cv::Mat &out) {
+        cv::cvtColor(gray, out, cv::COLOR_GRAY2BGR);
+        return 0;
+    }, 0});
+    effects.push_back({"Gray (Custom)", [this](cv::Mat &out) {
+        return v2::greyscale(small, out);
+    }, 0});
+    effects.push_back({"Sepia", [this](cv::Mat &out) {
+        return v2::sepia(small, out);
+    }, 0});
+    effects.push_back({"Blur 5x5", [this](cv::Mat &out) {
+        blurred.copyTo(out);
+        return 0;
+    }, 0});
+    effects.push_back({"Sobel X", [this](cv::Mat &out) {
+        cv::convertScaleAbs(gradX, out);
+        return 0;
+    }, 0});
+    effects.push_back({"Sobel Y", [this](cv::Mat &out) {
+        cv::convertScaleAbs(gradY, out);
+        return 0;
+    }, 0});
+    effects.push_back({"Magnitude", [this](cv::Mat &out) {
+        return magnitude(gradX, gradY, out, MAGNITUDE_INT_SQRT);
+    }, 0});
+    effects.push_back({"Cartoon", [this](cv::Mat &out) {
+        if (quantize(blurred, out, cartoonLevels) != 0) {
+            return -1;
+        }
+        // Per-pixel, so the edge pass can darken the quantized tile in place
+        return darkenEdgesGradients(out, lumaGradX, lumaGradY, out);
+    }, 0});
+    effects.push_back({"Faces", [this](cv::Mat &out) {
+        return v2::drawFaceBoxes(small, faces, out);
+    }, 0});
+    effects.push_back({"Depth", [this](cv::Mat &out) {
+        cv::applyColorMap(depth, out, cv::COLORMAP_TURBO);
+        return 0;
+    }, 0});
+    effects.push_back({"Depth Focus", [this](cv::Mat &out) {
+        blur5x5_2(blurred, blurredTwice);
+        return depthBlend(small, blurredTwice, depth, out);
+    }, 0});
+    effects.push_back({"Sketch", [this](cv::Mat &out) {
+        return sketchFromGradients(lumaGradX, lumaGradY, out);
+    }, 0});
+    effects.push_back({"Spotlight", [this](cv::Mat &out) {
+        return v2::spotlightFace(small, faces, out);
+    }, 0});
+    effects.push_back({"Glitch", [this](cv::Mat &out) {
+        return glitchFromLuma(gray, 1, out, seed);
+    }, 0});
+    effects.push_back({"Color Pop", [this](cv::Mat &out) {
+        return v2::colorPop(small, out, 2);
+    }, 0});
+    effects.push_back({"Spider-Man", [this](cv::Mat &out) {
+        return v2::spidermanMask(small, faces, out);
+    }, 0});
+}
+
+/*
+ * run - Worker loop: wait for a new batch, then claim tasks until it is drained
+ */
+void EffectsMosaic::run() {
+    long long seen = 0;
+
+    for (;;) {
+        std::shared_ptr<Batch> work;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            work = batch;
+        }
+
+        while (runTask(*work)) {
+        }
+    }
+}
+
+bool EffectsMosaic::runTask(Batch &work) {
+    int index = work.next.fetch_add(1);
+    if (index >= (int)work.tasks.size()) {
+        return false;
+    }
+
+    work.tasks[index]();
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (--work.pending == 0) {
+        done.notify_all();
+    }
+    return true;
+}
+
+/*
+ * runBatch - Run tasks on the pool and the calling thread, returning once all have finished
+ * Workers hold their own reference to the batch, so one that wakes late only finds it drained.
+ */
+void EffectsMosaic::runBatch(std::vector<std::function<void()>> tasks) {
+    std::shared_ptr<Batch> work = std::make_shared<Batch>();
+    work->tasks.swap(tasks);
+    work->next = 0;
+    work->pending = (int)work->tasks.size();
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        batch = work;
+        generation++;
+    }
+    wake.notify_all();
+
+    while (runTask(*work)) {
+    }
+
+    std::unique_lock<std::mutex> guard(lock);
+    done.wait(guard, [&] { return work->pending == 0; });
+}
+
+/*
+ * render - Compute the shared inputs once, then render and place every tile in parallel
+ */
+int EffectsMosaic::render(const cv::Mat &frame, cv::Mat &dst) {
+    if (frame.empty() || frame.type() != CV_8UC3) {
+        return -1;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Even tile sizes that keep the frame's aspect ratio and fit the grid
+    int count = (int)effects.size();
+    int gridRows = (count + columns - 1) / columns;
+    int tileW = frame.cols / columns;
+    int tileH = std::min(frame.rows / gridRows, tileW * frame.rows / frame.cols);
+    tileW = std::min(tileW, tileH * frame.cols / frame.rows);
+    tileW &= ~1;
+    tileH &= ~1;
+    if (tileW < 2 || tileH < 2) {
+        return -1;
+    }
+
+    // Shared inputs; gray comes first because the luma gradients and depth read it
+    cv::resize(frame, small, cv::Size(tileW, tileH), 0, 0, cv::INTER_AREA);
+    cv::cvtColor(small, gray, cv::COLOR_BGR2GRAY);
+    seed++;
+
+    // Scale the depth smoothing window with the tile so it covers the same part of the scene
+    int depthBlur = std::max(3, (31 * tileW / 640) | 1);
+
+    std::vector<std::function<void()>> shared = {
+        [&] { sobelX3x3(small, gradX); },
+        [&] { sobelY3x3(small, gradY); },
+        [&] { sobelX3x3(gray, lumaGradX); },
+        [&] { sobelY3x3(gray, lumaGradY); },
+        [&] { blur5x5_2(small, blurred); },
+        [&] { estimateDepthGray(gray, depth, depthBlur); },
+        [&] {
+            // Faces shrink below the cascade's 30 px minimum at tile size, so detect at half resolution
+            cv::Mat half;
+            cv::resize(frame, half, cv::Size(frame.cols / 2, frame.rows / 2), 0, 0, cv::INTER_AREA);
+            cv::cvtColor(half, detectGray, cv::COLOR_BGR2GRAY);
+            std::vector<cv::Rect> found;
+            detectFacesGray(detectGray, found);
+            double faceScale = (double)tileW / half.cols;
+            faces.clear();
+            for (size_t i = 0; i < found.size(); i++) {
+                cv::Rect r = found[i];
+                faces.push_back(cv::Rect((int)(r.x * faceScale), (int)(r.y * faceScale),
+                                         (int)(r.width * faceScale), (int)(r.height * faceScale)));
+            }
+        }
+    };
+    runBatch(shared);
+
+    auto sharedEnd = std::chrono::high_resolution_clock::now();
+
+    // frame is no longer read, so dst may share its buffer
+    dst.create(frame.rows, frame.cols, CV_8UC3);
+    dst.setTo(cv::Scalar(0, 0, 0));
+
+    int offsetX = (frame.cols - columns * tileW) / 2;
+    int offsetY = (frame.rows - gridRows * tileH) / 2;
+
+    std::vector<std::function<void()>> tileTasks;
+    for (int k = 0; k < count; k++) {
+        tileTasks.push_back([&, k] {
+            auto tileStart = std::chrono::high_resolution_clock::now();
+            cv::Mat &tile = tiles[k];
+            if (effects[k].render(tile) != 0 || tile.type() != CV_8UC3 || tile.size() != small.size()) {
+                small.copyTo(tile);
+            }
+            auto tileEnd = std::chrono::high_resolution_clock::now();
+            effects[k].totalMs += std::chrono::duration_cast<std::chrono::microseconds>(tileEnd - tileStart).count() / 1000.0;
+
+            // Tiles cover disjoint regions of dst, so they are placed without locking
+            cv::Mat cell = dst(cv::Rect(offsetX + (k % columns) * tileW, offsetY + (k / columns) * tileH, tileW, tileH));
+            tile.copyTo(cell);
+            cv::putText(cell, effects[k].name, cv::Point(4, tileH - 6),
+                        cv::FONT_HERSHEY_SIMPLEX, 0.35, cv::Scalar(0, 255, 255), 1);
+        });
+    }
+    runBatch(tileTasks);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    lastMs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+    totalFrameMs += lastMs;
+    totalSharedMs += std::chrono::duration_cast<std::chrono::microseconds>(sharedEnd - start).count() / 1000.0;
+    framesRendered++;
+
+    return 0;
+}
+
+void EffectsMosaic::printStats() const {
+    if (framesRendered == 0) {
+        return;
+    }
+
+    double seconds = totalFrameMs / 1000.0;
+    std::cout << "Mosaic frames: " << framesRendered << ", " << totalFrameMs / framesRendered << " ms/frame"
+              << ", " << framesRendered / seconds << " frames/s"
+              << ", " << framesRendered * effects.size() / seconds << " effects/s" << std::endl;
+    std::cout << "  Shared inputs: " << totalSharedMs / framesRendered << " ms/frame" << std::endl;
+    for (size_t k = 0; k < effects.size(); k++) {
+        std::cout << "  " << effects[k].name << ": " << effects[k].totalMs / framesRendered << " ms" << std::endl;
+    }
+}
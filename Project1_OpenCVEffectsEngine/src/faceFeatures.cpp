@@ -0,0 +1,241 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * faceFeatures.cpp
+ * Eye and smile cascades run on packed per-face bands.
+ */
+
+#include "faceFeatures.h"
+#include "filters.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+// Every face is scaled to this width before packing, so one size range fits all faces
+static const int cellSize = 128;
+
+// Largest window each cascade scans. The empty columns between cells are as wide as the
+// largest window, so a window that starts inside one face's cell ends before the next one.
+static const cv::Size eyeMaxWindow(56, 56);
+static const cv::Size smileMaxWindow(110, 60);
+
+// Eye and mouth bands as fractions of the face height (the two overlap slightly)
+static const float eyeTop = 0.20f;
+static const float eyeBottom = 0.60f;
+static const float mouthTop = 0.55f;
+static const float mouthBottom = 1.0f;
+
+/*
+ * loadCascade - Load a classifier, reporting a missing file once
+ */
+static bool loadCascade(cv::CascadeClassifier &cascade, const std::string &path) {
+    if (!cascade.load(path)) {
+        std::cout << "Error loading " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static cv::CascadeClassifier *eyeCascade() {
+    static cv::CascadeClassifier cascade;
+    static const bool loaded = loadCascade(cascade, "../data/haarcascades/haarcascade_eye.xml");
+    return loaded ? &cascade : nullptr;
+}
+
+static cv::CascadeClassifier *smileCascade() {
+    static cv::CascadeClassifier cascade;
+    static const bool loaded = loadCascade(cascade, "../data/haarcascades/haarcascade_smile.xml");
+    return loaded ? &cascade : nullptr;
+}
+
+int preloadFaceFeatureCascades() {
+    bool eyes = eyeCascade() != nullptr;
+    bool smiles = smileCascade() != nullptr;
+    return (eyes && smiles) ? 0 : -1;
+}
+
+/*
+ * bandRect - Rows top..bottom (fractions of the height) of a face, clipped to the image
+ */
+static cv::Rect bandRect(const cv::Rect &face, float top, float bottom, cv::Size size) {
+    int y0 = face.y + (int)(face.height * top);
+    int y1 = face.y + (int)(face.height * bottom);
+    return cv::Rect(face.x, y0, face.width, y1 - y0) & cv::Rect(0, 0, size.width, size.height);
+}
+
+/*
+ * packBands - Scale one band of every face into its own cell of a single strip
+ * Each cell is equalized on its own so faces under different lighting look alike to the cascade.
+ * gap is the empty width after each cell.
+ */
+static void packBands(cv::Mat &gray, const std::vector<cv::Rect> &faces, float top, float bottom, int gap,
+                      cv::Mat &strip) {
+    int bandHeight = (int)(cellSize * (bottom - top) + 0.5f);
+    strip.create(bandHeight, (int)faces.size() * (cellSize + gap), CV_8UC1);
+    strip.setTo(cv::Scalar(0));
+
+    for (size_t k = 0; k < faces.size(); k++) {
+        cv::Rect band = bandRect(faces[k], top, bottom, gray.size());
+        if (band.empty()) {
+            continue;
+        }
+
+        cv::Mat cell = strip(cv::Rect((int)k * (cellSize + gap), 0, cellSize, bandHeight));
+        cv::resize(gray(band), cell, cell.size(), 0, 0, cv::INTER_AREA);
+        cv::equalizeHist(cell, cell);
+    }
+}
+
+/*
+ * unpackDetections - Map strip detections back to frame coordinates of the face they fall in
+ * Keeps the largest maxPerFace hits per face, ordered left to right.
+ */
+static void unpackDetections(const std::vector<cv::Rect> &found, const std::vector<cv::Rect> &faces,
+                             float top, float bottom, int gap, cv::Size frameSize, size_t maxPerFace,
+                             std::vector<FaceFeatures> &features, bool eyes) {
+    int bandHeight = (int)(cellSize * (bottom - top) + 0.5f);
+    int pitch = cellSize + gap;
+
+    std::vector<std::vector<cv::Rect>> perFace(faces.size());
+    for (size_t i = 0; i < found.size(); i++) {
+        const cv::Rect &r = found[i];
+        int centerX = r.x + r.width / 2;
+        size_t k = centerX / pitch;
+        if (k >= faces.size() || centerX - (int)k * pitch >= cellSize) {
+            continue;
+        }
+
+        cv::Rect band = bandRect(faces[k], top, bottom, frameSize);
+        float scaleX = (float)band.width / cellSize;
+        float scaleY = (float)band.height / bandHeight;
+        perFace[k].push_back(cv::Rect(band.x + (int)((r.x - (int)k * pitch) * scaleX),
+                                      band.y + (int)(r.y * scaleY),
+                                      (int)(r.width * scaleX), (int)(r.height * scaleY)));
+    }
+
+    for (size_t k = 0; k < faces.size(); k++) {
+        std::vector<cv::Rect> &hits = perFace[k];
+        std::sort(hits.begin(), hits.end(), [](const cv::Rect &a, const cv::Rect &b) { return a.area() > b.area(); });
+        if (hits.size() > maxPerFace) {
+            hits.resize(maxPerFace);
+        }
+        std::sort(hits.begin(), hits.end(), [](const cv::Rect &a, const cv::Rect &b) { return a.x < b.x; });
+
+        if (eyes) {
+            features[k].eyes = hits;
+        } else {
+            features[k].smiles = hits;
+        }
+    }
+}
+
+cv::Rect alignedFace(const FaceFeatures &features) {
+    const cv::Rect &face = features.face;
+    if (features.eyes.size() != 2) {
+        return face;
+    }
+
+    const cv::Rect &left = features.eyes[0];
+    const cv::Rect &right = features.eyes[1];
+    int midX = (left.x + left.width / 2 + right.x + right.width / 2) / 2;
+    int midY = (left.y + left.height / 2 + right.y + right.height / 2) / 2;
+
+    // The eye line sits about 40% of the way down a frontal face box
+    return cv::Rect(midX - face.width / 2, midY - (int)(face.height * 0.4f), face.width, face.height);
+}
+
+FaceFeatureDetector::FaceFeatureDetector()
+    : faceMs(0), packMs(0), eyeMs(0), smileMs(0), frames(0), facesSeen(0), eyesFound(0), smilesFound(0) {}
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+int FaceFeatureDetector::detect(cv::Mat &gray, std::vector<FaceFeatures> &features) {
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<cv::Rect> faces;
+    int result = detectFacesGray(gray, faces);
+    faceMs += elapsedMs(start);
+
+    if (result != 0) {
+        features.clear();
+        frames++;
+        return result;
+    }
+    return detectInFaces(gray, faces, features);
+}
+
+/*
+ * detectInFaces - Pack the eye and mouth bands, then run both cascades side by side
+ * The two cascades are separate objects, so running them concurrently needs no locking.
+ */
+int FaceFeatureDetector::detectInFaces(cv::Mat &gray, const std::vector<cv::Rect> &faces,
+                                       std::vector<FaceFeatures> &features) {
+    if (gray.type() != CV_8UC1) {
+        return -1;
+    }
+
+    frames++;
+    features.assign(faces.size(), FaceFeatures());
+    for (size_t k = 0; k < faces.size(); k++) {
+        features[k].face = faces[k];
+    }
+    if (faces.empty()) {
+        return 0;
+    }
+
+    cv::CascadeClassifier *eyes = eyeCascade();
+    cv::CascadeClassifier *smiles = smileCascade();
+
+    auto packStart = std::chrono::high_resolution_clock::now();
+    cv::Mat eyeStrip, mouthStrip;
+    packBands(gray, faces, eyeTop, eyeBottom, eyeMaxWindow.width, eyeStrip);
+    packBands(gray, faces, mouthTop, mouthBottom, smileMaxWindow.width, mouthStrip);
+    packMs += elapsedMs(packStart);
+
+    std::vector<cv::Rect> eyeHits, smileHits;
+    double stageMs[2] = {0, 0};
+
+    cv::parallel_for_(cv::Range(0, 2), [&](const cv::Range &range) {
+        for (int stage = range.start; stage < range.end; stage++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            if (stage == 0 && eyes) {
+                // Eyes in a 128-pixel face are roughly 20-40 pixels across
+                eyes->detectMultiScale(eyeStrip, eyeHits, 1.1, 3, 0, cv::Size(16, 16), eyeMaxWindow);
+            } else if (stage == 1 && smiles) {
+                // The smile cascade fires easily, so it needs many more neighbours
+                smiles->detectMultiScale(mouthStrip, smileHits, 1.1, 15, 0, cv::Size(40, 20), smileMaxWindow);
+            }
+            stageMs[stage] = elapsedMs(start);
+        }
+    });
+
+    eyeMs += stageMs[0];
+    smileMs += stageMs[1];
+
+    unpackDetections(eyeHits, faces, eyeTop, eyeBottom, eyeMaxWindow.width, gray.size(), 2, features, true);
+    unpackDetections(smileHits, faces, mouthTop, mouthBottom, smileMaxWindow.width, gray.size(), 1, features, false);
+
+    facesSeen += faces.size();
+    for (size_t k = 0; k < features.size(); k++) {
+        eyesFound += features[k].eyes.size();
+        smilesFound += features[k].smiles.size();
+    }
+
+    return (eyes && smiles) ? 0 : -1;
+}
+
+void FaceFeatureDetector::printStats() const {
+    if (frames == 0) {
+        return;
+    }
+
+    std::cout << "Feature detection over " << frames << " frames (ms/frame): faces " << faceMs / frames
+              << ", packing " << packMs / frames << ", eyes " << eyeMs / frames
+              << ", smiles " << smileMs / frames << std::endl;
+    std::cout << "  Faces: " << facesSeen << ", eyes: " << eyesFound << ", smiles: " << smilesFound << std::endl;
+}
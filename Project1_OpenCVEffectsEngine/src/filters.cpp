@@ -10,285 +10,253 @@
  */
 
 #include "filters.h"
+#include "separableConv.h"
+#include "overlay.h"
+#include "pixelFilters.h"
+#include "perfCounters.h"
 #include <chrono>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
 
 /*
  * greyscale - Custom grayscale conversion using inverted red channel
  * Creates unique artistic effect with emphasized cool tones and higher contrast.
+ * Accepts 8UC1/3/4 and 16UC1/3 directly; the output has the source type.
  */
 int greyscale(cv::Mat &src, cv::Mat &dst) {
-    dst.create(src.rows, src.cols, CV_8UC3);
-
-    for (int i = 0; i < src.rows; i++) {
-        cv::Vec3b *srcRow = src.ptr<cv::Vec3b>(i);
-        cv::Vec3b *dstRow = dst.ptr<cv::Vec3b>(i);
-
-        for (int j = 0; j < src.cols; j++) {
-            unsigned char red = srcRow[j][2];
-            unsigned char gray = 255 - red;
-
-            dstRow[j][0] = gray;
-            dstRow[j][1] = gray;
-            dstRow[j][2] = gray;
-        }
-    }
-    return 0;
+    return dispatchPixelFormat(src.type(), [&](auto format) {
+        typedef decltype(format) F;
+        return pixel::greyscale<typename F::type, F::channels>(src, dst);
+    });
 }
 
 /*
  * sepia - Apply sepia tone filter for vintage photograph effect
  * Uses standard transformation matrix with original RGB values, clamps output to prevent overflow.
+ * Accepts 8UC1/3/4 and 16UC1/3 directly; gray input produces a 3-channel result of the same depth.
  */
 int sepia(cv::Mat &src, cv::Mat &dst) {
-    dst.create(src.rows, src.cols, CV_8UC3);
-
-    for (int i = 0; i < src.rows; i++) {
-        cv::Vec3b *srcRow = src.ptr<cv::Vec3b>(i);
-        cv::Vec3b *dstRow = dst.ptr<cv::Vec3b>(i);
-
-        for (int j = 0; j < src.cols; j++) {
-            unsigned char blue = srcRow[j][0];
-            unsigned char green = srcRow[j][1];
-            unsigned char red = srcRow[j][2];
-
-            float newBlue = 0.272 * red + 0.534 * green + 0.131 * blue;
-            float newGreen = 0.349 * red + 0.686 * green + 0.168 * blue;
-            float newRed = 0.393 * red + 0.769 * green + 0.189 * blue;
-
-            dstRow[j][0] = (newBlue > 255) ? 255 : (unsigned char)newBlue;
-            dstRow[j][1] = (newGreen > 255) ? 255 : (unsigned char)newGreen;
-            dstRow[j][2] = (newRed > 255) ? 255 : (unsigned char)newRed;
-        }
-    }
-    return 0;
+    return dispatchPixelFormat(src.type(), [&](auto format) {
+        typedef decltype(format) F;
+        return pixel::sepia<typename F::type, F::channels>(src, dst);
+    });
 }
 
 /*
  * blur5x5_1 - Naive 5x5 Gaussian blur implementation
- * Straightforward implementation using full kernel with at() accessor, performs 25 multiplications per pixel.
+ * Full kernel, 25 multiplications per pixel per channel; accepts 8UC1/3/4 and 16UC1/3.
  */
 int blur5x5_1(cv::Mat &src, cv::Mat &dst) {
-
-    dst = src.clone();
-
-    int kernel[5][5] = {
-        {1, 2, 4, 2, 1},
-        {2, 4, 8, 4, 2},
-        {4, 8, 16, 8, 4},
-        {2, 4, 8, 4, 2},
-        {1, 2, 4, 2, 1}
-    };
-
-    for (int i = 2; i < src.rows - 2; i++) {
-        for (int j = 2; j < src.cols - 2; j++) {
-
-            int blueSum = 0, greenSum = 0, redSum = 0;
-
-            for (int ki = -2; ki <= 2; ki++) {
-                for (int kj = -2; kj <= 2; kj++) {
-
-                    cv::Vec3b pixel = src.at<cv::Vec3b>(i + ki, j + kj);
-                    int weight = kernel[ki + 2][kj + 2];
-
-                    blueSum += pixel[0] * weight;
-                    greenSum += pixel[1] * weight;
-                    redSum += pixel[2] * weight;
-                }
-            }
-
-            dst.at<cv::Vec3b>(i, j)[0] = blueSum / 256;
-            dst.at<cv::Vec3b>(i, j)[1] = greenSum / 256;
-            dst.at<cv::Vec3b>(i, j)[2] = redSum / 256;
-        }
-    }
-
-    return 0;
+    return dispatchPixelFormat(src.type(), [&](auto format) {
+        typedef decltype(format) F;
+        return pixel::blur5x5_1<typename F::type, F::channels>(src, dst);
+    });
 }
 
 /*
  * blur5x5_2 - Optimized 5x5 Gaussian blur using separable filters
- * Decomposes 2D convolution into horizontal and vertical passes, uses pointer arithmetic for faster memory access.
+ * Thin instantiation of separableConvolve with the [1 2 4 2 1]/16 kernel in both directions.
+ * Supports 8-bit and 16-bit images with 1, 3 or 4 channels, and may run in place.
  */
 int blur5x5_2(cv::Mat &src, cv::Mat &dst) {
-    cv::Mat temp;
-    temp.create(src.rows, src.cols, CV_8UC3);
-
-    int filter[5] = {1, 2, 4, 2, 1};
-
-    // Horizontal pass
-    for (int i = 0; i < src.rows; i++) {
-        cv::Vec3b *srcRow = src.ptr<cv::Vec3b>(i);
-        cv::Vec3b *tempRow = temp.ptr<cv::Vec3b>(i);
-
-        for (int j = 2; j < src.cols - 2; j++) {
-            int blueSum = 0, greenSum = 0, redSum = 0;
-
-            for (int k = -2; k <= 2; k++) {
-                blueSum += srcRow[j + k][0] * filter[k + 2];
-                greenSum += srcRow[j + k][1] * filter[k + 2];
-                redSum += srcRow[j + k][2] * filter[k + 2];
-            }
-
-            tempRow[j][0] = blueSum / 16;
-            tempRow[j][1] = greenSum / 16;
-            tempRow[j][2] = redSum / 16;
-        }
-
-        // Copy boundary pixels
-        if (i < 2 || i >= src.rows - 2) {
-            for (int j = 0; j < src.cols; j++) {
-                tempRow[j] = srcRow[j];
-            }
-        } else {
-            tempRow[0] = srcRow[0];
-            tempRow[1] = srcRow[1];
-            tempRow[src.cols - 2] = srcRow[src.cols - 2];
-            tempRow[src.cols - 1] = srcRow[src.cols - 1];
-        }
+    switch (src.type()) {
+        case CV_8UC1:  return separableConvolve<Gauss5Kernel, Gauss5Kernel, uchar, uchar, 1>(src, dst);
+        case CV_8UC3:  return separableConvolve<Gauss5Kernel, Gauss5Kernel, uchar, uchar, 3>(src, dst);
+        case CV_8UC4:  return separableConvolve<Gauss5Kernel, Gauss5Kernel, uchar, uchar, 4>(src, dst);
+        case CV_16UC1: return separableConvolve<Gauss5Kernel, Gauss5Kernel, ushort, ushort, 1>(src, dst);
+        case CV_16UC3: return separableConvolve<Gauss5Kernel, Gauss5Kernel, ushort, ushort, 3>(src, dst);
+        case CV_16UC4: return separableConvolve<Gauss5Kernel, Gauss5Kernel, ushort, ushort, 4>(src, dst);
+        default:       return -1;
     }
-
-    dst.create(src.rows, src.cols, CV_8UC3);
-
-    // Vertical pass
-    for (int i = 2; i < temp.rows - 2; i++) {
-        cv::Vec3b *dstRow = dst.ptr<cv::Vec3b>(i);
-
-        for (int j = 0; j < temp.cols; j++) {
-            int blueSum = 0, greenSum = 0, redSum = 0;
-
-            for (int k = -2; k <= 2; k++) {
-                cv::Vec3b *tempRow = temp.ptr<cv::Vec3b>(i + k);
-                blueSum += tempRow[j][0] * filter[k + 2];
-                greenSum += tempRow[j][1] * filter[k + 2];
-                redSum += tempRow[j][2] * filter[k + 2];
-            }
-
-            dstRow[j][0] = blueSum / 16;
-            dstRow[j][1] = greenSum / 16;
-            dstRow[j][2] = redSum / 16;
-        }
-    }
-
-    for (int i = 0; i < 2; i++) {
-        src.row(i).copyTo(dst.row(i));
-        src.row(src.rows - 1 - i).copyTo(dst.row(dst.rows - 1 - i));
-    }
-
-    return 0;
 }
 
 /*
  * sobelX3x3 - Sobel X filter for vertical edge detection
- * Detects vertical edges using separable filters, output uses signed 16-bit integers to preserve gradient polarity.
+ * Derivative [-1 0 1] horizontally, smoothing [1 2 1] vertically; output uses signed 16-bit
+ * integers to preserve gradient polarity (32-bit for 16-bit input). Border pixels are zero.
  */
 int sobelX3x3(cv::Mat &src, cv::Mat &dst) {
+    switch (src.type()) {
+        case CV_8UC1: return separableConvolve<SobelDerivKernel, SobelSmoothKernel, uchar, short, 1, ConvBorder::Zero>(src, dst);
+        case CV_8UC3: return separableConvolve<SobelDerivKernel, SobelSmoothKernel, uchar, short, 3, ConvBorder::Zero>(src, dst);
+        case CV_8UC4: return separableConvolve<SobelDerivKernel, SobelSmoothKernel, uchar, short, 4, ConvBorder::Zero>(src, dst);
+        case CV_16UC1: return separableConvolve<SobelDerivKernel, SobelSmoothKernel, ushort, int, 1, ConvBorder::Zero>(src, dst);
+        case CV_16UC3: return separableConvolve<SobelDerivKernel, SobelSmoothKernel, ushort, int, 3, ConvBorder::Zero>(src, dst);
+        default:      return -1;
+    }
+}
 
-    cv::Mat temp;
-    temp.create(src.rows, src.cols, CV_16SC3);
-    dst.create(src.rows, src.cols, CV_16SC3);
-
-    // Horizontal derivative
-    for (int i = 0; i < src.rows; i++) {
-        cv::Vec3b *srcRow = src.ptr<cv::Vec3b>(i);
-        cv::Vec3s *tempRow = temp.ptr<cv::Vec3s>(i);
+/*
+ * sobelY3x3 - Sobel Y filter for horizontal edge detection
+ * Smoothing [1 2 1] horizontally, derivative [-1 0 1] vertically; output uses signed 16-bit integers
+ * (32-bit for 16-bit input).
+ */
+int sobelY3x3(cv::Mat &src, cv::Mat &dst) {
+    switch (src.type()) {
+        case CV_8UC1: return separableConvolve<SobelSmoothKernel, SobelDerivKernel, uchar, short, 1, ConvBorder::Zero>(src, dst);
+        case CV_8UC3: return separableConvolve<SobelSmoothKernel, SobelDerivKernel, uchar, short, 3, ConvBorder::Zero>(src, dst);
+        case CV_8UC4: return separableConvolve<SobelSmoothKernel, SobelDerivKernel, uchar, short, 4, ConvBorder::Zero>(src, dst);
+        case CV_16UC1: return separableConvolve<SobelSmoothKernel, SobelDerivKernel, ushort, int, 1, ConvBorder::Zero>(src, dst);
+        case CV_16UC3: return separableConvolve<SobelSmoothKernel, SobelDerivKernel, ushort, int, 3, ConvBorder::Zero>(src, dst);
+        default:      return -1;
+    }
+}
 
-        for (int j = 1; j < src.cols - 1; j++) {
-            for (int c = 0; c < 3; c++) {
-                tempRow[j][c] = -srcRow[j-1][c] + srcRow[j+1][c];
-            }
+/*
+ * sqrtTable - floor(sqrt(s)) for every s below 65536, capped at 255
+ * Any sum of squares past 255^2 saturates anyway, so 64 KB covers the whole useful range.
+ */
+static const unsigned char *sqrtTable() {
+    static const std::vector<unsigned char> table = [] {
+        std::vector<unsigned char> t(65536);
+        for (int s = 0; s < 65536; s++) {
+            t[s] = (unsigned char)std::min((int)sqrt((double)s), 255);
         }
+        return t;
+    }();
+    return table.data();
+}
 
-        tempRow[0] = cv::Vec3s(0, 0, 0);
-        tempRow[src.cols - 1] = cv::Vec3s(0, 0, 0);
+/*
+ * magnitudeRow - One flattened row of gradient magnitudes in the chosen mode
+ * Each mode is a straight loop over n values with no branches in the body; apart from the
+ * table lookup they are plain integer min/max/add/shift and vectorize. Tin is short for 8-bit
+ * images (output clamped to 255) or int for 16-bit images (output clamped to 65535).
+ */
+template <typename Tin, typename Tout>
+static void magnitudeRow(const Tin *sx, const Tin *sy, Tout *dst, int n, MagnitudeMode mode) {
+    const int maxValue = std::numeric_limits<Tout>::max();
+
+    // The sqrt table only covers 8-bit output
+    if (mode == MAGNITUDE_INT_SQRT && sizeof(Tout) == 1) {
+        const unsigned char *table = sqrtTable();
+        for (int k = 0; k < n; k++) {
+            int gx = sx[k];
+            int gy = sy[k];
+            dst[k] = (Tout)table[std::min(gx * gx + gy * gy, 65535)];
+        }
+    } else if (mode == MAGNITUDE_EXACT || mode == MAGNITUDE_INT_SQRT) {
+        for (int k = 0; k < n; k++) {
+            float gx = sx[k];
+            float gy = sy[k];
+            float mag = sqrt(gx * gx + gy * gy);
+            dst[k] = (Tout)std::min(mag, (float)maxValue);
+        }
+    } else if (mode == MAGNITUDE_L1) {
+        for (int k = 0; k < n; k++) {
+            int mag = std::abs((int)sx[k]) + std::abs((int)sy[k]);
+            dst[k] = (Tout)std::min(mag, maxValue);
+        }
+    } else {
+        // alpha = 15/16, beta = 15/32
+        for (int k = 0; k < n; k++) {
+            int ax = std::abs((int)sx[k]);
+            int ay = std::abs((int)sy[k]);
+            int hi = std::max(ax, ay);
+            int lo = std::min(ax, ay);
+            int mag = ((15 * hi) >> 4) + ((15 * lo) >> 5);
+            dst[k] = (Tout)std::min(mag, maxValue);
+        }
     }
+}
 
-    // Vertical smoothing
-    for (int i = 1; i < temp.rows - 1; i++) {
-        cv::Vec3s *dstRow = dst.ptr<cv::Vec3s>(i);
+/*
+ * magnitude - Compute gradient magnitude from Sobel X and Y outputs
+ * Combines horizontal and vertical gradients per channel with clamping. Works for any channel
+ * count; 16S gradients (8-bit images) give 8U, 32S gradients (16-bit images) give 16U.
+ * See MagnitudeMode for the accuracy of each mode.
+ */
+int magnitude(cv::Mat &sx, cv::Mat &sy, cv::Mat &dst, MagnitudeMode mode) {
+    if (sx.type() != sy.type() || sx.size() != sy.size()) {
+        return -1;
+    }
 
-        for (int j = 0; j < temp.cols; j++) {
-            cv::Vec3s *tempRowPrev = temp.ptr<cv::Vec3s>(i - 1);
-            cv::Vec3s *tempRowCurr = temp.ptr<cv::Vec3s>(i);
-            cv::Vec3s *tempRowNext = temp.ptr<cv::Vec3s>(i + 1);
+    int n = sx.cols * sx.channels();
 
-            for (int c = 0; c < 3; c++) {
-                dstRow[j][c] = tempRowPrev[j][c] + 2 * tempRowCurr[j][c] + tempRowNext[j][c];
-            }
+    if (sx.depth() == CV_16S) {
+        dst.create(sx.rows, sx.cols, CV_8UC(sx.channels()));
+        for (int i = 0; i < sx.rows; i++) {
+            magnitudeRow(sx.ptr<short>(i), sy.ptr<short>(i), dst.ptr<unsigned char>(i), n, mode);
+        }
+    } else if (sx.depth() == CV_32S) {
+        dst.create(sx.rows, sx.cols, CV_MAKETYPE(CV_16U, sx.channels()));
+        for (int i = 0; i < sx.rows; i++) {
+            magnitudeRow(sx.ptr<int>(i), sy.ptr<int>(i), dst.ptr<unsigned short>(i), n, mode);
         }
+    } else {
+        return -1;
     }
-
-    dst.row(0).setTo(cv::Scalar(0, 0, 0));
-    dst.row(dst.rows - 1).setTo(cv::Scalar(0, 0, 0));
-
     return 0;
 }
 
 /*
- * sobelY3x3 - Sobel Y filter for horizontal edge detection
- * Detects horizontal edges using separable filters, output uses signed 16-bit integers.
+ * quantize - Posterize each channel into discrete levels
+ * Maps every value down to the start of its bucket of width maxValue / levels.
+ * Accepts 8UC1/3/4 and 16UC1/3; 8-bit data goes through a cached lookup table.
  */
-int sobelY3x3(cv::Mat &src, cv::Mat &dst) {
-
-    cv::Mat temp;
-    temp.create(src.rows, src.cols, CV_16SC3);
-    dst.create(src.rows, src.cols, CV_16SC3);
-
-    // Horizontal smoothing
-    for (int i = 0; i < src.rows; i++) {
-        cv::Vec3b *srcRow = src.ptr<cv::Vec3b>(i);
-        cv::Vec3s *tempRow = temp.ptr<cv::Vec3s>(i);
+int quantize(cv::Mat &src, cv::Mat &dst, int levels) {
+    return dispatchPixelFormat(src.type(), [&](auto format) {
+        typedef decltype(format) F;
+        return pixel::quantize<typename F::type, F::channels>(src, dst, levels);
+    });
+}
 
-        for (int j = 1; j < src.cols - 1; j++) {
-            for (int c = 0; c < 3; c++) {
-                tempRow[j][c] = srcRow[j-1][c] + 2 * srcRow[j][c] + srcRow[j+1][c];
-            }
+/*
+ * darkenEdges - Draw black outlines where the gradient of edgeSrc is strong
+ * Copies colors to dst and blacks out pixels whose luma Sobel magnitude exceeds 80.
+ */
+int darkenEdges(cv::Mat &colors, cv::Mat &edgeSrc, cv::Mat &dst) {
+    cv::Mat luma(edgeSrc.rows, edgeSrc.cols, CV_8UC1);
+    for (int i = 0; i < edgeSrc.rows; i++) {
+        unsigned char *srcRow = edgeSrc.ptr<unsigned char>(i);
+        unsigned char *lumaRow = luma.ptr<unsigned char>(i);
+        for (int j = 0; j < edgeSrc.cols; j++) {
+            unsigned char *p = srcRow + 3 * j;
+            lumaRow[j] = (unsigned char)((p[0] * 29 + p[1] * 150 + p[2] * 77 + 128) >> 8);
         }
-
-        tempRow[0] = cv::Vec3s(0, 0, 0);
-        tempRow[src.cols - 1] = cv::Vec3s(0, 0, 0);
     }
 
-    // Vertical derivative
-    for (int i = 1; i < temp.rows - 1; i++) {
-        cv::Vec3s *dstRow = dst.ptr<cv::Vec3s>(i);
-
-        for (int j = 0; j < temp.cols; j++) {
-            cv::Vec3s *tempRowPrev = temp.ptr<cv::Vec3s>(i - 1);
-            cv::Vec3s *tempRowNext = temp.ptr<cv::Vec3s>(i + 1);
+    cv::Mat sobelX, sobelY;
+    sobelX3x3(luma, sobelX);
+    sobelY3x3(luma, sobelY);
+    return darkenEdgesGradients(colors, sobelX, sobelY, dst);
+}
 
-            for (int c = 0; c < 3; c++) {
-                dstRow[j][c] = -tempRowPrev[j][c] + tempRowNext[j][c];
-            }
-        }
+/*
+ * darkenEdgesGradients - Edge darkening from precomputed luma Sobel outputs
+ * Lets callers that already hold the gradients skip the luma and Sobel passes.
+ */
+int darkenEdgesGradients(cv::Mat &colors, cv::Mat &sobelX, cv::Mat &sobelY, cv::Mat &dst) {
+    if (colors.type() != CV_8UC3 || sobelX.type() != CV_16SC1 || sobelY.type() != CV_16SC1 ||
+        sobelX.size() != colors.size() || sobelY.size() != colors.size()) {
+        return -1;
     }
 
-    dst.row(0).setTo(cv::Scalar(0, 0, 0));
-    dst.row(dst.rows - 1).setTo(cv::Scalar(0, 0, 0));
+    // Truncated magnitude above 80, compared squared to avoid the sqrt
+    const int edgeLimit = 81 * 81;
 
-    return 0;
-}
+    dst.create(colors.rows, colors.cols, CV_8UC3);
 
-/*
- * magnitude - Compute gradient magnitude from Sobel X and Y outputs
- * Combines horizontal and vertical gradients using Euclidean distance, computed per channel with clamping to 255.
- */
-int magnitude(cv::Mat &sx, cv::Mat &sy, cv::Mat &dst) {
-    dst.create(sx.rows, sx.cols, CV_8UC3);
-    
-    for (int i = 0; i < sx.rows; i++) {
-        cv::Vec3s *sxRow = sx.ptr<cv::Vec3s>(i);
-        cv::Vec3s *syRow = sy.ptr<cv::Vec3s>(i);
+    for (int i = 0; i < colors.rows; i++) {
+        cv::Vec3b *colorsRow = colors.ptr<cv::Vec3b>(i);
+        short *sxRow = sobelX.ptr<short>(i);
+        short *syRow = sobelY.ptr<short>(i);
         cv::Vec3b *dstRow = dst.ptr<cv::Vec3b>(i);
 
-        for (int j = 0; j < sx.cols; j++) {
-            for (int c = 0; c < 3; c++) {
-                float gx = sxRow[j][c];
-                float gy = syRow[j][c];
-
-                float mag = sqrt(gx * gx + gy * gy);
-                if (mag > 255) mag = 255;
+        for (int j = 0; j < colors.cols; j++) {
+            int gx = sxRow[j];
+            int gy = syRow[j];
 
-                dstRow[j][c] = (unsigned char)mag;
+            if (gx * gx + gy * gy >= edgeLimit) {
+                dstRow[j][0] = 0;
+                dstRow[j][1] = 0;
+                dstRow[j][2] = 0;
+            } else {
+                for (int c = 0; c < 3; c++) {
+                    dstRow[j][c] = colorsRow[j][c];
+                }
             }
         }
     }
@@ -298,57 +266,96 @@ int magnitude(cv::Mat &sx, cv::Mat &sy, cv::Mat &dst) {
 /*
  * blurQuantize - Cartoon effect combining blur, quantization, and edge darkening
  * Creates comic book style by blurring, posterizing colors into discrete levels, and darkening strong edges.
+ * Single pass: the 5x5 blur keeps a ring of five horizontally filtered rows, the Sobel edge test
+ * runs on a rolling window of three luma rows, and each output pixel is quantized through a
+ * lookup table and written in the same loop as the blur's vertical pass.
  */
 int blurQuantize(cv::Mat &src, cv::Mat &dst, int levels) {
-    cv::Mat blurred;
-    blur5x5_2(src, blurred);
-    
-    cv::Mat quantized;
-    quantized.create(src.rows, src.cols, CV_8UC3);
+    if (src.type() != CV_8UC3 || levels < 1 || levels > 255) {
+        return -1;
+    }
 
-    int bucketSize = 255 / levels;
+    // Output rows are written while later source rows are still being read
+    cv::Mat input = (dst.data == src.data) ? src.clone() : src;
 
-    // Color quantization
-    for (int i = 0; i < blurred.rows; i++) {
-        cv::Vec3b *blurredRow = blurred.ptr<cv::Vec3b>(i);
-        cv::Vec3b *quantizedRow = quantized.ptr<cv::Vec3b>(i);
+    const unsigned char *table = pixel::quantizeTable(levels);
+    const int rows = input.rows;
+    const int cols = input.cols;
+    const int rowLen = cols * 3;
 
-        for (int j = 0; j < blurred.cols; j++) {
-            for (int c = 0; c < 3; c++) {
-                int value = blurredRow[j][c];
-                int q = (value / bucketSize) * bucketSize;
-                quantizedRow[j][c] = (unsigned char)q;
-            }
+    // Truncated Sobel magnitude above 80, compared squared to avoid the sqrt
+    const int edgeLimit = 81 * 81;
+
+    dst.create(rows, cols, CV_8UC3);
+
+    bool blurFits = rows >= Gauss5Kernel::size && cols >= Gauss5Kernel::size;
+
+    std::vector<int> blurRing(Gauss5Kernel::size * rowLen);
+    std::vector<int> lumaRing(3 * cols);
+    auto blurSlot = [&](int k) { return blurRing.data() + (k % Gauss5Kernel::size) * rowLen; };
+    auto lumaSlot = [&](int k) { return lumaRing.data() + (k % 3) * cols; };
+
+    // Same BT.601 integer weights as the glitch effect
+    auto lumaPass = [&](int k) {
+        const unsigned char *s = input.ptr<unsigned char>(k);
+        int *l = lumaSlot(k);
+        for (int j = 0; j < cols; j++) {
+            l[j] = (s[3 * j] * 29 + s[3 * j + 1] * 150 + s[3 * j + 2] * 77 + 128) >> 8;
         }
-    }
+    };
 
-    // Edge detection on original
-    cv::Mat sobelX, sobelY;
-    sobelX3x3(src, sobelX);
-    sobelY3x3(src, sobelY);
+    lumaPass(0);
+    if (blurFits) {
+        for (int k = 0; k < Gauss5Kernel::size - 1; k++) {
+            conv_detail::horizontalPass<Gauss5Kernel, uchar, 3, ConvBorder::Copy>(
+                input.ptr<uchar>(k), blurSlot(k), cols);
+        }
+    }
 
-    cv::Mat edges;
-    magnitude(sobelX, sobelY, edges);
-    
-    dst.create(src.rows, src.cols, CV_8UC3);
+    for (int i = 0; i < rows; i++) {
+        if (i + 1 < rows) {
+            lumaPass(i + 1);
+        }
 
-    // Combine quantized colors with edge outlines
-    for (int i = 0; i < quantized.rows; i++) {
-        cv::Vec3b *quantizedRow = quantized.ptr<cv::Vec3b>(i);
-        cv::Vec3b *edgesRow = edges.ptr<cv::Vec3b>(i);
-        cv::Vec3b *dstRow = dst.ptr<cv::Vec3b>(i);
+        bool blurRow = blurFits && i >= 2 && i < rows - 2;
+        if (blurRow) {
+            conv_detail::horizontalPass<Gauss5Kernel, uchar, 3, ConvBorder::Copy>(
+                input.ptr<uchar>(i + 2), blurSlot(i + 2), cols);
+        }
 
-        for (int j = 0; j < quantized.cols; j++) {
-            int edgeStrength = edgesRow[j][0];
+        // Sobel output is zero on the outermost rows and columns, so they never count as edges
+        bool edgeRow = i >= 1 && i < rows - 1 && cols >= 3;
+        // Ring slots: i + 2 is row i - 1 modulo 3, i + 3 and i + 4 are rows i - 2 and i - 1 modulo 5
+        const int *up = lumaSlot(i + 2);
+        const int *mid = lumaSlot(i);
+        const int *down = lumaSlot(i + 1);
+
+        const int *w0 = blurSlot(i + 3);
+        const int *w1 = blurSlot(i + 4);
+        const int *w2 = blurSlot(i);
+        const int *w3 = blurSlot(i + 1);
+        const int *w4 = blurSlot(i + 2);
+
+        const unsigned char *srcRow = input.ptr<unsigned char>(i);
+        unsigned char *dstRow = dst.ptr<unsigned char>(i);
+
+        for (int j = 0; j < cols; j++) {
+            bool edge = false;
+            if (edgeRow && j >= 1 && j < cols - 1) {
+                int gx = (up[j + 1] - up[j - 1]) + 2 * (mid[j + 1] - mid[j - 1]) + (down[j + 1] - down[j - 1]);
+                int gy = (down[j - 1] + 2 * down[j] + down[j + 1]) - (up[j - 1] + 2 * up[j] + up[j + 1]);
+                edge = gx * gx + gy * gy >= edgeLimit;
+            }
 
-            if (edgeStrength > 80) {
-                dstRow[j][0] = 0;
-                dstRow[j][1] = 0;
-                dstRow[j][2] = 0;
-            } else {
-                for (int c = 0; c < 3; c++) {
-                    dstRow[j][c] = quantizedRow[j][c];
+            for (int c = 0; c < 3; c++) {
+                int k = 3 * j + c;
+                int blurred;
+                if (blurRow) {
+                    blurred = (w0[k] + 2 * w1[k] + 4 * w2[k] + 2 * w3[k] + w4[k]) >> 4;
+                } else {
+                    blurred = srcRow[k];
                 }
+                dstRow[k] = edge ? 0 : table[blurred];
             }
         }
     }
@@ -358,40 +365,58 @@ int blurQuantize(cv::Mat &src, cv::Mat &dst, int levels) {
 
 /*
  * detectFaces - Detect faces using Haar cascade classifier
- * Loads cascade on first call, applies histogram equalization for robust detection under varying lighting.
+ * Converts to grayscale and runs detectFacesGray.
  */
 int detectFaces(cv::Mat &frame, std::vector<cv::Rect> &faces) {
-    static cv::CascadeClassifier face_cascade;
-    static bool loaded = false;
+    cv::Mat gray;
+    cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+
+    return detectFacesGray(gray, faces);
+}
 
-    if (!loaded) {
-        if (!face_cascade.load("../data/haarcascade_frontalface_alt2.xml")) {
+/*
+ * faceCascade - Shared frontal face classifier, parsed on first use
+ * The function-local static is initialized exactly once even when the preload thread and a
+ * detection call race for it; the loser simply waits for the parse to finish.
+ */
+static cv::CascadeClassifier *faceCascade() {
+    static cv::CascadeClassifier cascade;
+    static const bool loaded = [] {
+        if (!cascade.load("../data/haarcascade_frontalface_alt2.xml")) {
             std::cout << "Error loading face cascade!" << std::endl;
-            return -1;
+            return false;
         }
-        loaded = true;
+        return true;
+    }();
+    return loaded ? &cascade : nullptr;
+}
+
+/*
+ * detectFacesGray - Face detection on an existing 8-bit luma image
+ * Loads cascade on first call, applies histogram equalization for robust detection under varying lighting.
+ * Lets callers that already have luma (e.g. a V4L2 Y plane) skip the color conversion.
+ * The input is left untouched so it may point into a capture buffer.
+ */
+int detectFacesGray(cv::Mat &gray, std::vector<cv::Rect> &faces) {
+    cv::CascadeClassifier *cascade = faceCascade();
+    if (!cascade) {
+        return -1;
     }
 
-    cv::Mat gray;
-    cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
-    cv::equalizeHist(gray, gray);
+    cv::Mat equalized;
+    cv::equalizeHist(gray, equalized);
 
-    face_cascade.detectMultiScale(gray, faces, 1.1, 3, 0, cv::Size(30, 30));
+    cascade->detectMultiScale(equalized, faces, 1.1, 3, 0, cv::Size(30, 30));
 
     return 0;
 }
 
 /*
- * depthFocusEffect - Portrait mode effect with depth-based selective blur
- * Creates shallow depth-of-field by blending sharp and blurred versions based on depth map values.
+ * depthBlend - Mix sharp and blurred frames by depth
+ * Near pixels (high depth value) keep the sharp frame, far pixels take the blurred one.
  */
-int depthFocusEffect(cv::Mat &src, cv::Mat &depth, cv::Mat &dst) {
-
-    cv::Mat blurred;
-    blur5x5_2(src, blurred);
-    blur5x5_2(blurred, blurred);
-
-    dst = src.clone();
+int depthBlend(cv::Mat &src, cv::Mat &blurred, cv::Mat &depth, cv::Mat &dst) {
+    dst.create(src.rows, src.cols, CV_8UC3);
 
     for (int i = 0; i < src.rows; i++) {
         cv::Vec3b *srcRow = src.ptr<cv::Vec3b>(i);
@@ -404,7 +429,7 @@ int depthFocusEffect(cv::Mat &src, cv::Mat &depth, cv::Mat &dst) {
             float blurAmount = 1.0f - depthValue;
 
             for (int c = 0; c < 3; c++) {
-                dstRow[j][c] = srcRow[j][c] * (1.0f - blurAmount) + 
+                dstRow[j][c] = srcRow[j][c] * (1.0f - blurAmount) +
                               blurredRow[j][c] * blurAmount;
             }
         }
@@ -412,6 +437,20 @@ int depthFocusEffect(cv::Mat &src, cv::Mat &depth, cv::Mat &dst) {
     return 0;
 }
 
+/*
+ * depthFocusEffect - Portrait mode effect with depth-based selective blur
+ * Creates shallow depth-of-field by blending sharp and blurred versions based on depth map values.
+ */
+int depthFocusEffect(cv::Mat &src, cv::Mat &depth, cv::Mat &dst) {
+
+    // Reused across frames; blur5x5_2 only reallocates when the frame size changes
+    thread_local cv::Mat blurred;
+    blur5x5_2(src, blurred);
+    blur5x5_2(blurred, blurred);
+
+    return depthBlend(src, blurred, depth, dst);
+}
+
 /*
  * sketchFilter - Pencil sketch effect using edge detection
  * Creates hand-drawn appearance by inverting edges with contrast enhancement and subtle paper tinting.
@@ -421,7 +460,8 @@ int sketchFilter(cv::Mat &src, cv::Mat &dst) {
     cv::Mat sobelX, sobelY, edges;
     sobelX3x3(src, sobelX);
     sobelY3x3(src, sobelY);
-    magnitude(sobelX, sobelY, edges);
+    // A few percent of magnitude error is invisible after the inversion and contrast curve
+    magnitude(sobelX, sobelY, edges, MAGNITUDE_ALPHA_MAX_BETA_MIN);
 
     cv::Mat gray;
     cv::cvtColor(edges, gray, cv::COLOR_BGR2GRAY);
@@ -448,104 +488,277 @@ int sketchFilter(cv::Mat &src, cv::Mat &dst) {
 }
 
 /*
- * spotlightFace - Dramatic lighting effect emphasizing detected faces
- * Creates theatrical spotlight with radial brightness masks and quadratic falloff, handles multiple faces.
+ * sketchFromLuma - Pencil sketch computed from a single luma plane
+ * Same tone mapping as sketchFilter, but one Sobel channel instead of three and no color conversion.
  */
-int spotlightFace(cv::Mat &src, std::vector<cv::Rect> &faces, cv::Mat &dst) {
-    dst = src.clone();
+int sketchFromLuma(cv::Mat &luma, cv::Mat &dst) {
 
-    if (faces.empty()) {
-        dst = dst * 0.3;
-        return 0;
+    cv::Mat sobelX, sobelY;
+    sobelX3x3(luma, sobelX);
+    sobelY3x3(luma, sobelY);
+    return sketchFromGradients(sobelX, sobelY, dst);
+}
+
+/*
+ * sketchFromGradients - Sketch filter from precomputed luma Sobel outputs
+ */
+int sketchFromGradients(cv::Mat &sobelX, cv::Mat &sobelY, cv::Mat &dst) {
+    if (sobelX.type() != CV_16SC1 || sobelY.type() != CV_16SC1) {
+        return -1;
+    }
+
+    cv::Mat edges;
+    magnitude(sobelX, sobelY, edges, MAGNITUDE_ALPHA_MAX_BETA_MIN);
+
+    dst.create(edges.rows, edges.cols, CV_8UC3);
+
+    for (int i = 0; i < edges.rows; i++) {
+        unsigned char *edgesRow = edges.ptr<unsigned char>(i);
+        cv::Vec3b *dstRow = dst.ptr<cv::Vec3b>(i);
+
+        for (int j = 0; j < edges.cols; j++) {
+            int inverted = 255 - edgesRow[j];
+
+            int value = (inverted > 200) ? 255 : inverted * 1.2;
+            if (value > 255) value = 255;
+
+            dstRow[j][0] = value * 0.9;
+            dstRow[j][1] = value * 0.95;
+            dstRow[j][2] = value;
+        }
     }
 
-    cv::Mat mask = cv::Mat::zeros(src.rows, src.cols, CV_32FC1);
+    return 0;
+}
+
+/*
+ * renderSpotlightSprite - 8-bit quadratic radial falloff filling a rectangle of the given size
+ */
+static cv::Mat renderSpotlightSprite(cv::Size size) {
+    int w = size.width;
+    int h = size.height;
+    cv::Mat sprite(h, w, CV_8UC1);
+    float centerX = w / 2.0f;
+    float centerY = h / 2.0f;
+    float maxDist = sqrt((float)(w * w + h * h)) / 2.0f;
+
+    for (int i = 0; i < h; i++) {
+        unsigned char *spriteRow = sprite.ptr<unsigned char>(i);
+        for (int j = 0; j < w; j++) {
+            float dx = j - centerX;
+            float dy = i - centerY;
+            float dist = sqrt(dx * dx + dy * dy);
+
+            float brightness = 1.0f - (dist / maxDist);
+            if (brightness < 0) brightness = 0;
+            brightness = brightness * brightness;
+
+            spriteRow[j] = (unsigned char)(brightness * 255.0f + 0.5f);
+        }
+    }
+    return sprite;
+}
+
+/*
+ * spotlightSprite - Cached falloff for an expanded face rectangle
+ * The falloff only depends on the rectangle size, so sprites are cached by size rounded up to
+ * a multiple of 8; faces that change size slightly reuse the same sprite.
+ */
+static cv::Mat spotlightSprite(int width, int height) {
+    // The largest preloaded sprite (416x416, one byte a pixel) is 173 KB, so 64 sizes stay near
+    // 11 MB while holding the 7 preloaded sizes plus the drift of several tracked faces
+    static SizeCache cache(64);
+    static std::mutex cacheLock;
+
+    int w = ((std::max(width, 1) + 7) / 8) * 8;
+    int h = ((std::max(height, 1) + 7) / 8) * 8;
+
+    std::lock_guard<std::mutex> guard(cacheLock);
+    return cache.get(cv::Size(w, h), renderSpotlightSprite);
+}
+
+/*
+ * spotlightMask - Radial brightness mask around each face
+ * Quadratic falloff over the face rectangle grown by expansion pixels; overlapping faces keep the maximum.
+ * Cached sprites are clipped to the frame and max-blended into an 8-bit mask (255 = fully lit).
+ */
+int spotlightMask(cv::Size size, const std::vector<cv::Rect> &faces, int expansion, cv::Mat &mask) {
+    mask.create(size.height, size.width, CV_8UC1);
+    mask.setTo(cv::Scalar(0));
+
+    cv::Rect bounds(0, 0, size.width, size.height);
 
     for (size_t f = 0; f < faces.size(); f++) {
         cv::Rect face = faces[f];
 
-        int expansion = 80;
-        cv::Rect expanded(
-            std::max(0, face.x - expansion),
-            std::max(0, face.y - expansion),
-            std::min(src.cols - face.x + expansion, face.width + 2 * expansion),
-            std::min(src.rows - face.y + expansion, face.height + 2 * expansion)
-        );
-
-        cv::Point2f center(face.x + face.width / 2.0f, face.y + face.height / 2.0f);
-        float maxDist = sqrt(expanded.width * expanded.width + expanded.height * expanded.height) / 2.0f;
-
-        for (int i = expanded.y; i < expanded.y + expanded.height && i < mask.rows; i++) {
-            float *maskRow = mask.ptr<float>(i);
-            for (int j = expanded.x; j < expanded.x + expanded.width && j < mask.cols; j++) {
-                float dx = j - center.x;
-                float dy = i - center.y;
-                float dist = sqrt(dx * dx + dy * dy);
-                
-                float brightness = 1.0f - (dist / maxDist);
-                if (brightness < 0) brightness = 0;
-                brightness = brightness * brightness;
+        cv::Mat sprite = spotlightSprite(face.width + 2 * expansion, face.height + 2 * expansion);
 
-                if (brightness > maskRow[j]) {
-                    maskRow[j] = brightness;
-                }
-            }
+        cv::Rect placed(face.x + face.width / 2 - sprite.cols / 2,
+                        face.y + face.height / 2 - sprite.rows / 2,
+                        sprite.cols, sprite.rows);
+        cv::Rect clipped = placed & bounds;
+        if (clipped.empty()) {
+            continue;
         }
+
+        cv::Mat maskRoi = mask(clipped);
+        cv::Mat spriteRoi = sprite(cv::Rect(clipped.x - placed.x, clipped.y - placed.y,
+                                            clipped.width, clipped.height));
+        cv::max(maskRoi, spriteRoi, maskRoi);
     }
+    return 0;
+}
 
-    for (int i = 0; i < dst.rows; i++) {
-        cv::Vec3b *dstRow = dst.ptr<cv::Vec3b>(i);
-        float *maskRow = mask.ptr<float>(i);
+/*
+ * spotlightScaleTable - Fixed-point (x256) brightness factor for each mask value
+ */
+static const unsigned short *spotlightScaleTable() {
+    static const std::vector<unsigned short> table = [] {
+        std::vector<unsigned short> t(256);
+        for (int m = 0; m < 256; m++) {
+            t[m] = (unsigned short)((0.2f + 0.8f * m / 255.0f) * 256.0f + 0.5f);
+        }
+        return t;
+    }();
+    return table.data();
+}
 
-        for (int j = 0; j < dst.cols; j++) {
-            float brightness = 0.2f + maskRow[j] * 0.8f;
+/*
+ * applySpotlight - Scale pixel brightness by a spotlight mask
+ * Mask value 0 leaves 20% brightness, 255 leaves the pixel unchanged. The factor for each mask
+ * value comes from a fixed-point (x256) table, so the pass is one lookup and one multiply per byte.
+ */
+int applySpotlight(cv::Mat &src, cv::Mat &mask, cv::Mat &dst) {
+    dst.create(src.rows, src.cols, CV_8UC3);
 
-            for (int c = 0; c < 3; c++) {
-                dstRow[j][c] = dstRow[j][c] * brightness;
-            }
+    const unsigned short *scaleLut = spotlightScaleTable();
+
+    for (int i = 0; i < src.rows; i++) {
+        unsigned char *srcRow = src.ptr<unsigned char>(i);
+        unsigned char *dstRow = dst.ptr<unsigned char>(i);
+        unsigned char *maskRow = mask.ptr<unsigned char>(i);
+
+        for (int j = 0; j < src.cols; j++) {
+            unsigned int scale = scaleLut[maskRow[j]];
+            dstRow[3 * j] = (unsigned char)((srcRow[3 * j] * scale) >> 8);
+            dstRow[3 * j + 1] = (unsigned char)((srcRow[3 * j + 1] * scale) >> 8);
+            dstRow[3 * j + 2] = (unsigned char)((srcRow[3 * j + 2] * scale) >> 8);
         }
     }
-
     return 0;
 }
 
+/*
+ * spotlightFace - Dramatic lighting effect emphasizing detected faces
+ * Creates theatrical spotlight with radial brightness masks and quadratic falloff, handles multiple faces.
+ */
+int spotlightFace(cv::Mat &src, const std::vector<cv::Rect> &faces, cv::Mat &dst) {
+    if (faces.empty()) {
+        src.convertTo(dst, -1, 0.3);
+        return 0;
+    }
+
+    thread_local cv::Mat mask;
+    spotlightMask(src.size(), faces, 80, mask);
+
+    return applySpotlight(src, mask, dst);
+}
+
+/*
+ * noiseHash - Counter-based hash used as a stateless PRNG
+ * Every output depends only on its input, so any pixel's noise can be computed independently
+ * (no shared generator state between threads) and the same seed always gives the same frame.
+ */
+static inline unsigned int noiseHash(unsigned int x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+/*
+ * glitchRow - One output row of the glitch effect
+ * Blends luma 50/50 with noise and darkens even rows to 70% (179/256) for the scanlines.
+ * Branch-free integer loop so the compiler can vectorize it.
+ */
+static inline void glitchRow(const unsigned char *luma, int pixelStride, int cols, int row,
+                             unsigned int key, cv::Vec3b *dstRow) {
+    unsigned int scan = (row % 2 == 0) ? 179 : 256;
+    unsigned int base = (unsigned int)row * (unsigned int)cols;
+
+    for (int j = 0; j < cols; j++) {
+        unsigned int noise = noiseHash((base + j) ^ key) >> 24;
+        unsigned int value = (((luma[j * pixelStride] + noise) >> 1) * scan) >> 8;
+        dstRow[j][0] = (unsigned char)value;
+        dstRow[j][1] = (unsigned char)value;
+        dstRow[j][2] = (unsigned char)value;
+    }
+}
+
 /*
  * glitchEffect - Analog TV interference simulation
  * Creates retro aesthetic with grayscale conversion, monochrome noise overlay, and scanlines.
+ * Luma, noise, blend and scanlines are computed in one pass, parallel over rows; seed selects
+ * the noise pattern so a frame can be reproduced exactly.
  */
-int glitchEffect(cv::Mat &src, cv::Mat &dst) {
+int glitchEffect(cv::Mat &src, cv::Mat &dst, unsigned int seed) {
+    dst.create(src.rows, src.cols, CV_8UC3);
+    unsigned int key = noiseHash(seed);
 
-    cv::Mat gray;
-    cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
-    cv::cvtColor(gray, dst, cv::COLOR_GRAY2BGR);
+    cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range &range) {
+        std::vector<unsigned char> luma(src.cols);
 
-    cv::Mat noise(src.rows, src.cols, CV_8UC3);
-    cv::randu(noise, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
+        for (int i = range.start; i < range.end; i++) {
+            cv::Vec3b *srcRow = src.ptr<cv::Vec3b>(i);
 
-    cv::Mat grayNoise;
-    cv::cvtColor(noise, grayNoise, cv::COLOR_BGR2GRAY);
-    cv::cvtColor(grayNoise, noise, cv::COLOR_GRAY2BGR);
+            // BT.601 luma in 8-bit fixed point, matching COLOR_BGR2GRAY
+            for (int j = 0; j < src.cols; j++) {
+                luma[j] = (unsigned char)((srcRow[j][0] * 29 + srcRow[j][1] * 150 + srcRow[j][2] * 77 + 128) >> 8);
+            }
 
-    for (int i = 0; i < src.rows; i++) {
+            glitchRow(luma.data(), 1, src.cols, i, key, dst.ptr<cv::Vec3b>(i));
+        }
+    });
+
+    return 0;
+}
+
+/*
+ * lumaToBGR - Display a luma plane as a gray BGR image
+ * Reads Y every pixelStride bytes, so packed YUYV buffers are consumed in place.
+ */
+int lumaToBGR(cv::Mat &plane, int pixelStride, cv::Mat &dst) {
+    dst.create(plane.rows, plane.cols, CV_8UC3);
+
+    for (int i = 0; i < plane.rows; i++) {
+        unsigned char *lumaRow = plane.ptr<unsigned char>(i);
         cv::Vec3b *dstRow = dst.ptr<cv::Vec3b>(i);
-        cv::Vec3b *noiseRow = noise.ptr<cv::Vec3b>(i);
 
-        for (int j = 0; j < src.cols; j++) {
-            for (int c = 0; c < 3; c++) {
-                dstRow[j][c] = dstRow[j][c] * 0.5 + noiseRow[j][c] * 0.5;
-            }
+        for (int j = 0; j < plane.cols; j++) {
+            unsigned char y = lumaRow[j * pixelStride];
+            dstRow[j][0] = y;
+            dstRow[j][1] = y;
+            dstRow[j][2] = y;
         }
     }
+    return 0;
+}
 
-    // Add scanlines
-    for (int i = 0; i < dst.rows; i += 2) {
-        cv::Vec3b *dstRow = dst.ptr<cv::Vec3b>(i);
-        for (int j = 0; j < dst.cols; j++) {
-            for (int c = 0; c < 3; c++) {
-                dstRow[j][c] *= 0.7;
-            }
+/*
+ * glitchFromLuma - Glitch effect reading luma directly from a capture buffer
+ * Same single pass as glitchEffect with Y read every pixelStride bytes.
+ */
+int glitchFromLuma(cv::Mat &plane, int pixelStride, cv::Mat &dst, unsigned int seed) {
+    dst.create(plane.rows, plane.cols, CV_8UC3);
+    unsigned int key = noiseHash(seed);
+
+    cv::parallel_for_(cv::Range(0, plane.rows), [&](const cv::Range &range) {
+        for (int i = range.start; i < range.end; i++) {
+            glitchRow(plane.ptr<unsigned char>(i), pixelStride, plane.cols, i, key, dst.ptr<cv::Vec3b>(i));
         }
-    }
+    });
 
     return 0;
 }
@@ -618,30 +831,38 @@ int colorPop(cv::Mat &src, cv::Mat &dst, int channelToKeep) {
     return 0;
 }
 
+/*
+ * spidermanOverlay - Premultiplied Spider-Man mask, decoded on first use
+ */
+static OverlayCache *spidermanOverlay() {
+    static OverlayCache overlay;
+    static const bool loaded = [] {
+        if (!overlay.load("../data/spiderman_mask.png")) {
+            std::cout << "Warning: Could not load spiderman_mask.png" << std::endl;
+            return false;
+        }
+        return true;
+    }();
+    return loaded ? &overlay : nullptr;
+}
+
 /*
  * spidermanMask - Overlay Spider-Man mask on detected faces
- * Dynamically scales and positions mask based on estimated head boundaries with alpha blending.
+ * Scales and positions the cached premultiplied mask over the estimated head boundaries.
  */
-int spidermanMask(cv::Mat &src, std::vector<cv::Rect> &faces, cv::Mat &dst) {
-    dst = src.clone();
+int spidermanMask(cv::Mat &src, const std::vector<cv::Rect> &faces, cv::Mat &dst) {
+    // Only the head rectangles change, so in place there is nothing to copy
+    if (dst.data != src.data) {
+        src.copyTo(dst);
+    }
 
     if (faces.empty()) {
         return 0;
     }
 
-    static cv::Mat maskImage;
-    static bool maskLoaded = false;
-
-    if (!maskLoaded) {
-        maskImage = cv::imread("../data/spiderman_mask.png", cv::IMREAD_UNCHANGED);
-        if (maskImage.empty()) {
-            maskImage = cv::imread("../data/spiderman_mask.png");
-        }
-        if (maskImage.empty()) {
-            std::cout << "Warning: Could not load spiderman_mask.png" << std::endl;
-            return -1;
-        }
-        maskLoaded = true;
+    OverlayCache *maskOverlay = spidermanOverlay();
+    if (!maskOverlay) {
+        return -1;
     }
 
     for (size_t f = 0; f < faces.size(); f++) {
@@ -650,76 +871,179 @@ int spidermanMask(cv::Mat &src, std::vector<cv::Rect> &faces, cv::Mat &dst) {
         int headWidth = face.width * 1.5;
         int headHeight = face.height * 1.8;
 
-        cv::Mat resizedMask;
-        cv::resize(maskImage, resizedMask, cv::Size(headWidth, headHeight));
-
         int xPos = face.x - (headWidth - face.width) / 2;
         int yPos = face.y - face.height * 0.4;
 
-        for (int y = 0; y < resizedMask.rows; y++) {
-            int dstY = yPos + y;
-            if (dstY < 0 || dstY >= dst.rows) continue;
+        maskOverlay->draw(dst, cv::Rect(xPos, yPos, headWidth, headHeight));
+    }
 
-            cv::Vec3b *dstRow = dst.ptr<cv::Vec3b>(dstY);
+    return 0;
+}
 
-            for (int x = 0; x < resizedMask.cols; x++) {
-                int dstX = xPos + x;
-                if (dstX < 0 || dstX >= dst.cols) continue;
+/*
+ * preloadFilterResources - Do every lazy first-use load ahead of time
+ * Parses the face cascade, decodes the mask, builds the lookup tables and renders spotlight
+ * sprites for typical webcam face sizes. Meant to run on a background thread at startup, so
+ * the first 'f', 'i' or 'o' press does not stall the render loop.
+ */
+int preloadFilterResources() {
+    int result = 0;
 
-                if (resizedMask.channels() == 4) {
-                    cv::Vec4b maskPixel = resizedMask.at<cv::Vec4b>(y, x);
-                    float alpha = maskPixel[3] / 255.0f;
+    if (!faceCascade()) {
+        result = -1;
+    }
+    if (!spidermanOverlay()) {
+        result = -1;
+    }
 
-                    if (alpha > 0.1) {
-                        for (int c = 0; c < 3; c++) {
-                            dstRow[dstX][c] = dstRow[dstX][c] * (1 - alpha) + maskPixel[c] * alpha;
-                        }
-                    }
-                } else {
-                    cv::Vec3b maskPixel = resizedMask.at<cv::Vec3b>(y, x);
+    sqrtTable();
+    spotlightScaleTable();
 
-                    if (maskPixel[0] + maskPixel[1] + maskPixel[2] > 30) {
-                        for (int c = 0; c < 3; c++) {
-                            dstRow[dstX][c] = dstRow[dstX][c] * 0.1 + maskPixel[c] * 0.9;
-                        }
-                    }
-                }
-            }
-        }
+    // Haar detections are square; spotlightFace grows each one by 80 pixels per side
+    for (int face = 64; face <= 256; face += 32) {
+        spotlightSprite(face + 160, face + 160);
     }
 
-    return 0;
+    return result;
 }
 
 /*
  * testBlurTiming - Performance comparison of blur implementations
- * Runs both implementations 100 times and reports average execution time and speedup factor.
+ * Runs both implementations 100 times and reports average execution time and speedup factor,
+ * plus hardware counters per megapixel where perf_event_open is available.
  */
 void testBlurTiming(cv::Mat &testImage) {
     cv::Mat dst1, dst2;
-    
-    auto start1 = std::chrono::high_resolution_clock::now();
+    PerfCounters counters;
+
+    counters.start();
     for (int i = 0; i < 100; i++) {
         blur5x5_1(testImage, dst1);
     }
-    auto end1 = std::chrono::high_resolution_clock::now();
-    auto duration1 = std::chrono::duration_cast<std::chrono::microseconds>(end1 - start1);
-    
-    auto start2 = std::chrono::high_resolution_clock::now();
+    CounterReading naive = counters.stop();
+
+    counters.start();
     for (int i = 0; i < 100; i++) {
         blur5x5_2(testImage, dst2);
     }
-    auto end2 = std::chrono::high_resolution_clock::now();
-    auto duration2 = std::chrono::duration_cast<std::chrono::microseconds>(end2 - start2);
-    
-    double avgTime1 = duration1.count() / 100.0 / 1000.0;
-    double avgTime2 = duration2.count() / 100.0 / 1000.0;
+    CounterReading separable = counters.stop();
+
+    double avgTime1 = naive.ms / 100.0;
+    double avgTime2 = separable.ms / 100.0;
     double speedup = avgTime1 / avgTime2;
-    
+
     std::cout << "\n=== Blur Timing Results ===" << std::endl;
     std::cout << "Image size: " << testImage.cols << "x" << testImage.rows << std::endl;
     std::cout << "blur5x5_1 (naive): " << avgTime1 << " ms" << std::endl;
     std::cout << "blur5x5_2 (separable): " << avgTime2 << " ms" << std::endl;
     std::cout << "Speedup: " << speedup << "x faster" << std::endl;
+
+    double megapixels = testImage.total() / 1e6;
+    PerfCounters::printHeader();
+    PerfCounters::printRow("blur5x5_1 (naive)", naive, megapixels, 100);
+    PerfCounters::printRow("blur5x5_2 (separable)", separable, megapixels, 100);
     std::cout << "=========================\n" << std::endl;
-}
\ No newline at end of file
+}
+
+/*
+ * testMagnitudeModes - Speed and accuracy of each magnitude mode
+ * Times 50 runs per mode on the image's Sobel gradients and reports the largest and mean
+ * absolute difference from the exact float result.
+ */
+void testMagnitudeModes(cv::Mat &testImage) {
+    const int runs = 50;
+    const char *names[4] = {"exact float", "integer sqrt", "|gx|+|gy|", "alpha-max-beta-min"};
+    MagnitudeMode modes[4] = {MAGNITUDE_EXACT, MAGNITUDE_INT_SQRT, MAGNITUDE_L1, MAGNITUDE_ALPHA_MAX_BETA_MIN};
+
+    cv::Mat sobelX, sobelY, reference;
+    sobelX3x3(testImage, sobelX);
+    sobelY3x3(testImage, sobelY);
+    magnitude(sobelX, sobelY, reference, MAGNITUDE_EXACT);
+
+    std::cout << "\n=== Magnitude Mode Results ===" << std::endl;
+    std::cout << "Image size: " << testImage.cols << "x" << testImage.rows << std::endl;
+
+    PerfCounters counters;
+    CounterReading readings[4];
+
+    for (int m = 0; m < 4; m++) {
+        cv::Mat out;
+        counters.start();
+        for (int r = 0; r < runs; r++) {
+            magnitude(sobelX, sobelY, out, modes[m]);
+        }
+        readings[m] = counters.stop();
+        double ms = readings[m].ms / runs;
+
+        int maxDiff = 0;
+        double sumDiff = 0;
+        int n = out.cols * out.channels();
+        for (int i = 0; i < out.rows; i++) {
+            unsigned char *outRow = out.ptr<unsigned char>(i);
+            unsigned char *refRow = reference.ptr<unsigned char>(i);
+            for (int k = 0; k < n; k++) {
+                int d = std::abs(outRow[k] - refRow[k]);
+                maxDiff = std::max(maxDiff, d);
+                sumDiff += d;
+            }
+        }
+
+        std::cout << names[m] << ": " << ms << " ms, max error " << maxDiff
+                  << ", mean error " << sumDiff / ((double)out.rows * n) << std::endl;
+    }
+
+    PerfCounters::printHeader();
+    for (int m = 0; m < 4; m++) {
+        PerfCounters::printRow(names[m], readings[m], testImage.total() / 1e6, runs);
+    }
+    std::cout << "==============================\n" << std::endl;
+}
+
+/*
+ * testFilterCounters - Hardware counters per megapixel for every classic filter stage
+ * Each stage runs 20 times after one warm-up call. Stages that stream full-frame temporaries
+ * show low IPC and many LLC misses per pixel; the float and sqrt paths show high IPC instead.
+ */
+void testFilterCounters(cv::Mat &testImage) {
+    const int runs = 20;
+    cv::Mat gray, sobelX, sobelY, out;
+    sobelX3x3(testImage, sobelX);
+    sobelY3x3(testImage, sobelY);
+    cv::cvtColor(testImage, gray, cv::COLOR_BGR2GRAY);
+
+    struct Stage {
+        const char *name;
+        std::function<void()> run;
+    };
+    std::vector<Stage> stages = {
+        {"greyscale", [&] { greyscale(testImage, out); }},
+        {"sepia", [&] { sepia(testImage, out); }},
+        {"blur5x5_1 (naive)", [&] { blur5x5_1(testImage, out); }},
+        {"blur5x5_2 (separable)", [&] { blur5x5_2(testImage, out); }},
+        {"sobelX3x3", [&] { sobelX3x3(testImage, out); }},
+        {"magnitude (float)", [&] { magnitude(sobelX, sobelY, out, MAGNITUDE_EXACT); }},
+        {"magnitude (int sqrt)", [&] { magnitude(sobelX, sobelY, out, MAGNITUDE_INT_SQRT); }},
+        {"quantize", [&] { quantize(testImage, out, 10); }},
+        {"blurQuantize", [&] { blurQuantize(testImage, out, 10); }},
+        {"sketchFromLuma", [&] { sketchFromLuma(gray, out); }},
+        {"colorPop", [&] { colorPop(testImage, out, 2); }},
+    };
+
+    PerfCounters counters;
+    std::cout << "\n=== Filter Hardware Counters ===" << std::endl;
+    std::cout << "Image size: " << testImage.cols << "x" << testImage.rows << std::endl;
+    if (!counters.available()) {
+        std::cout << "perf_event_open unavailable (check /proc/sys/kernel/perf_event_paranoid); timings only" << std::endl;
+    }
+
+    PerfCounters::printHeader();
+    for (size_t i = 0; i < stages.size(); i++) {
+        stages[i].run();
+        counters.start();
+        for (int r = 0; r < runs; r++) {
+            stages[i].run();
+        }
+        PerfCounters::printRow(stages[i].name, counters.stop(), testImage.total() / 1e6, runs);
+    }
+    std::cout << "================================\n" << std::endl;
+}
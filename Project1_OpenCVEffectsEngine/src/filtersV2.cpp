@@ -0,0 +1,158 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * filtersV2.cpp
+ * Const-input, output-reusing, ROI-aware wrappers over the filter kernels.
+ */
+
+#include "filtersV2.h"
+#include "filters.h"
+
+namespace v2 {
+
+/*
+ * applyRegion - Run filter over roi of src and write the result into dst
+ * halo is how far the filter reads past a pixel. Per-pixel filters (halo 0) write straight into
+ * the dst sub-matrix; neighbourhood filters read roi grown by halo into a per-thread scratch
+ * buffer and copy back only roi, which also keeps in-place calls correct.
+ */
+template <typename Fn>
+static int applyRegion(const cv::Mat &src, cv::Mat &dst, cv::Rect roi, int halo, Fn filter) {
+    if (src.empty()) {
+        return -1;
+    }
+
+    cv::Rect bounds(0, 0, src.cols, src.rows);
+    roi = (roi.area() == 0) ? bounds : (roi & bounds);
+
+    bool inPlace = dst.data == src.data && dst.size() == src.size() && dst.type() == src.type();
+
+    if (!inPlace) {
+        // Whole frame into a separate buffer: the kernel's own create() reuses dst
+        if (roi == bounds) {
+            cv::Mat in = src;
+            return filter(in, dst);
+        }
+        src.copyTo(dst);
+    }
+
+    if (roi.empty()) {
+        return 0;
+    }
+
+    cv::Mat region = dst(roi);
+
+    if (halo == 0) {
+        // Per-pixel kernels read each pixel before writing it, so the views may alias
+        cv::Mat in = src(roi);
+        cv::Mat out = region;
+        if (filter(in, out) != 0) {
+            return -1;
+        }
+        if (out.data != region.data) {
+            // The kernel changed type, so the result cannot live inside dst
+            return -1;
+        }
+        return 0;
+    }
+
+    cv::Rect read = cv::Rect(roi.x - halo, roi.y - halo, roi.width + 2 * halo, roi.height + 2 * halo) & bounds;
+
+    thread_local cv::Mat scratch;
+    cv::Mat in = src(read);
+    if (filter(in, scratch) != 0 || scratch.type() != dst.type()) {
+        return -1;
+    }
+
+    cv::Rect inner(roi.x - read.x, roi.y - read.y, roi.width, roi.height);
+    scratch(inner).copyTo(region);
+    return 0;
+}
+
+int greyscale(const cv::Mat &src, cv::Mat &dst, cv::Rect roi) {
+    return applyRegion(src, dst, roi, 0, [](cv::Mat &in, cv::Mat &out) { return ::greyscale(in, out); });
+}
+
+int sepia(const cv::Mat &src, cv::Mat &dst, cv::Rect roi) {
+    return applyRegion(src, dst, roi, 0, [](cv::Mat &in, cv::Mat &out) { return ::sepia(in, out); });
+}
+
+int blur5x5(const cv::Mat &src, cv::Mat &dst, cv::Rect roi) {
+    return applyRegion(src, dst, roi, 2, [](cv::Mat &in, cv::Mat &out) { return blur5x5_2(in, out); });
+}
+
+int blurQuantize(const cv::Mat &src, cv::Mat &dst, int levels, cv::Rect roi) {
+    return applyRegion(src, dst, roi, 2, [levels](cv::Mat &in, cv::Mat &out) {
+        return ::blurQuantize(in, out, levels);
+    });
+}
+
+int sketch(const cv::Mat &src, cv::Mat &dst, cv::Rect roi) {
+    return applyRegion(src, dst, roi, 1, [](cv::Mat &in, cv::Mat &out) { return sketchFilter(in, out); });
+}
+
+int colorPop(const cv::Mat &src, cv::Mat &dst, int channelToKeep, cv::Rect roi) {
+    return applyRegion(src, dst, roi, 0, [channelToKeep](cv::Mat &in, cv::Mat &out) {
+        return ::colorPop(in, out, channelToKeep);
+    });
+}
+
+/*
+ * drawFaceBoxes - Outline each face
+ * In place nothing but the rectangle outlines is written.
+ */
+int drawFaceBoxes(const cv::Mat &src, const std::vector<cv::Rect> &faces, cv::Mat &dst) {
+    if (src.empty()) {
+        return -1;
+    }
+    if (dst.data != src.data) {
+        src.copyTo(dst);
+    }
+    for (size_t i = 0; i < faces.size(); i++) {
+        cv::rectangle(dst, faces[i], cv::Scalar(0, 255, 0), 3);
+    }
+    return 0;
+}
+
+/*
+ * spotlightFace - Spotlight without the legacy full-frame clone
+ * applySpotlight reads each pixel before writing it, so dst may be src.
+ */
+int spotlightFace(const cv::Mat &src, const std::vector<cv::Rect> &faces, cv::Mat &dst) {
+    if (src.type() != CV_8UC3) {
+        return -1;
+    }
+
+    cv::Mat in = src;
+    return ::spotlightFace(in, faces, dst);
+}
+
+/*
+ * spidermanMask - Composite the mask over each head
+ * Only the head rectangles are written, so in place nothing else in the frame is touched.
+ */
+int spidermanMask(const cv::Mat &src, const std::vector<cv::Rect> &faces, cv::Mat &dst) {
+    if (src.type() != CV_8UC3) {
+        return -1;
+    }
+    if (dst.data != src.data) {
+        src.copyTo(dst);
+    }
+
+    return ::spidermanMask(dst, faces, dst);
+}
+
+int depthFocusEffect(const cv::Mat &src, const cv::Mat &depth, cv::Mat &dst) {
+    if (src.type() != CV_8UC3 || depth.type() != CV_8UC1 || depth.size() != src.size()) {
+        return -1;
+    }
+
+    cv::Mat in = src;
+    cv::Mat depthView = depth;
+    return ::depthFocusEffect(in, depthView, dst);
+}
+
+} // namespace v2
@@ -0,0 +1,218 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * frameRecorder.cpp
+ * Bounded-queue encoder thread for snapshots, VideoWriter recording and raw frame dumps.
+ */
+
+#include "frameRecorder.h"
+#include <iostream>
+
+FrameRecorder::FrameRecorder(size_t queueCapacity, BackpressurePolicy policy)
+    : capacity(queueCapacity), policy(policy), stopping(false), recordFps(30.0), clipFrames(0), recording(false),
+      snapshotsSaved(0), framesRecorded(0), snapshotsDropped(0), framesDropped(0) {
+    worker = std::thread(&FrameRecorder::run, this);
+}
+
+FrameRecorder::~FrameRecorder() {
+    finish();
+}
+
+void FrameRecorder::finish() {
+    if (!worker.joinable()) {
+        return;
+    }
+    stopRecording();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    notEmpty.notify_one();
+    worker.join();
+}
+
+/*
+ * enqueue - Add a job, applying the backpressure policy to frame jobs
+ * Control jobs (start/stop) always get in so recordings are closed properly.
+ */
+bool FrameRecorder::enqueue(Job &job, bool isFrame) {
+    std::unique_lock<std::mutex> guard(lock);
+
+    if (stopping) {
+        return false;
+    }
+
+    if (isFrame && queue.size() >= capacity) {
+        if (policy == BACKPRESSURE_DROP) {
+            return false;
+        }
+        notFull.wait(guard, [this] { return queue.size() < capacity; });
+    }
+
+    queue.push_back(std::move(job));
+    guard.unlock();
+    notEmpty.notify_one();
+    return true;
+}
+
+bool FrameRecorder::saveSnapshot(const cv::Mat &frame, const std::string &filename) {
+    Job job{JOB_SNAPSHOT, frame.clone(), filename, 0.0};
+    if (!enqueue(job, true)) {
+        snapshotsDropped++;
+        return false;
+    }
+    return true;
+}
+
+void FrameRecorder::startRecording(const std::string &path, double fps) {
+    if (recording) {
+        stopRecording();
+    }
+    Job job{JOB_START, cv::Mat(), path, fps};
+    enqueue(job, false);
+    recording = true;
+}
+
+void FrameRecorder::stopRecording() {
+    if (!recording) {
+        return;
+    }
+    Job job{JOB_STOP, cv::Mat(), "", 0.0};
+    enqueue(job, false);
+    recording = false;
+}
+
+bool FrameRecorder::recordFrame(const cv::Mat &frame) {
+    if (!recording) {
+        return false;
+    }
+    Job job{JOB_RECORD, frame.clone(), "", 0.0};
+    if (!enqueue(job, true)) {
+        framesDropped++;
+        return false;
+    }
+    return true;
+}
+
+void FrameRecorder::setPolicy(BackpressurePolicy newPolicy) {
+    policy = newPolicy;
+}
+
+/*
+ * run - Worker loop; drains the queue before exiting
+ */
+void FrameRecorder::run() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            notEmpty.wait(guard, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                break;
+            }
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        notFull.notify_one();
+
+        process(job);
+    }
+
+    videoWriter.release();
+    if (rawFile.is_open()) {
+        rawFile.close();
+    }
+}
+
+/*
+ * process - Encode or write one job on the worker thread
+ */
+void FrameRecorder::process(Job &job) {
+    if (job.type == JOB_SNAPSHOT) {
+        if (cv::imwrite(job.path, job.frame)) {
+            snapshotsSaved++;
+            std::cout << "Saved: " << job.path << std::endl;
+        } else {
+            std::cout << "Error: could not save " << job.path << std::endl;
+        }
+    } else if (job.type == JOB_START) {
+        // Writer is opened lazily on the first frame, once the size is known
+        videoWriter.release();
+        recordPath = job.path;
+        recordFps = job.fps;
+        recordSize = cv::Size();
+        clipFrames = 0;
+
+        bool raw = job.path.size() >= 4 && job.path.compare(job.path.size() - 4, 4, ".raw") == 0;
+        if (raw) {
+            rawFile.open(job.path, std::ios::binary);
+        } else {
+            rawFile.close();
+        }
+        if (raw && !rawFile.is_open()) {
+            std::cout << "Error: could not open " << job.path << std::endl;
+            recordPath.clear();
+        }
+    } else if (job.type == JOB_STOP) {
+        videoWriter.release();
+        if (rawFile.is_open()) {
+            rawFile.close();
+        }
+        if (!recordPath.empty()) {
+            std::cout << "Recording stopped: " << recordPath << " (" << clipFrames << " frames)" << std::endl;
+        }
+        recordPath.clear();
+    } else if (job.type == JOB_RECORD) {
+        // Frames for a recording whose file could not be opened are lost, so they count as dropped
+        if (recordPath.empty()) {
+            framesDropped++;
+            return;
+        }
+
+        if (recordSize.width == 0) {
+            recordSize = job.frame.size();
+            if (rawFile.is_open()) {
+                std::cout << "Recording raw " << recordSize.width << "x" << recordSize.height
+                          << " type " << job.frame.type() << " frames to " << recordPath << std::endl;
+            } else {
+                videoWriter.open(recordPath, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'),
+                                 recordFps, recordSize, job.frame.channels() == 3);
+                if (!videoWriter.isOpened()) {
+                    std::cout << "Error: could not open video writer for " << recordPath << std::endl;
+                }
+                std::cout << "Recording to " << recordPath << std::endl;
+            }
+        }
+
+        // A recording has one frame size; anything else counts as dropped
+        if (job.frame.size() != recordSize) {
+            framesDropped++;
+            return;
+        }
+
+        if (rawFile.is_open()) {
+            for (int i = 0; i < job.frame.rows; i++) {
+                rawFile.write((const char *)job.frame.ptr(i), job.frame.cols * job.frame.elemSize());
+            }
+            framesRecorded++;
+            clipFrames++;
+        } else if (videoWriter.isOpened()) {
+            videoWriter.write(job.frame);
+            framesRecorded++;
+            clipFrames++;
+        } else {
+            framesDropped++;
+        }
+    }
+}
+
+/*
+ * printStats - Report encoder counters
+ */
+void FrameRecorder::printStats() const {
+    std::cout << "Snapshots saved: " << snapshotsSaved << " (dropped " << snapshotsDropped << ")" << std::endl;
+    std::cout << "Frames recorded: " << framesRecorded << " (dropped " << framesDropped << ")" << std::endl;
+}
@@ -0,0 +1,145 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * frameRingReader.cpp
+ * Reference consumer for the shared-memory frame ring published by
+ * vidDisplay --shm <name>. Frames are viewed in place, never copied out of the
+ * ring; a frame counts only if its slot was not overwritten while it was used.
+ * Usage: frameRingReader <name> [--latest] [--headless] [--seconds N] [--work ms]
+ *   --latest  always jump to the newest frame instead of reading every frame
+ *   --work    pretend each frame takes this long, to watch the reader fall behind
+ */
+
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "sharedFrameRing.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <name> [--latest] [--headless] [--seconds N] [--work ms]" << std::endl;
+        return -1;
+    }
+
+    std::string name = argv[1];
+    bool latestOnly = false;
+    bool headless = false;
+    double seconds = 0;
+    int workMs = 0;
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--latest") {
+            latestOnly = true;
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        } else if (arg == "--work" && i + 1 < argc) {
+            workMs = atoi(argv[++i]);
+        }
+    }
+
+    SharedFrameRing ring;
+    if (!ring.open(name)) {
+        return -1;
+    }
+    std::cout << "Reading " << name << " (" << ring.slotCount() << " slots)" << std::endl;
+
+    if (!headless) {
+        cv::namedWindow("Frame Ring", 1);
+    }
+
+    Clock::time_point start = Clock::now();
+    long long used = 0;
+    long long discarded = 0;
+    double latencyMs = 0;
+    double maxLatencyMs = 0;
+    double brightness = 0;
+    int idlePolls = 0;
+    bool seen = false;
+    uint64_t lastFrame = 0;
+    RingFrame frame;
+
+    for (;;) {
+        if (seconds > 0 && std::chrono::duration<double>(Clock::now() - start).count() >= seconds) {
+            break;
+        }
+
+        bool got = latestOnly ? ring.latest(frame) : ring.next(frame);
+        if (got && latestOnly && seen && frame.frameNumber == lastFrame) {
+            got = false;
+        }
+        if (!got) {
+            // Nothing new; give up after a few seconds without a frame (producer gone)
+            if (++idlePolls > 5000) {
+                std::cout << "No frames for 5 s, stopping" << std::endl;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        idlePolls = 0;
+        seen = true;
+        lastFrame = frame.frameNumber;
+
+        double latency = (nowNs() - frame.timestampNs) / 1e6;
+
+        // Use the frame straight from shared memory
+        double frameBrightness = 0;
+        if (headless) {
+            frameBrightness = cv::mean(frame.image)[0];
+        } else {
+            cv::imshow("Frame Ring", frame.image);
+        }
+        if (workMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(workMs));
+        }
+
+        // The writer may have lapped us while we worked; whatever we computed is then garbage
+        if (!ring.stillValid(frame)) {
+            discarded++;
+            continue;
+        }
+        used++;
+        brightness += frameBrightness;
+        latencyMs += latency;
+        if (latency > maxLatencyMs) {
+            maxLatencyMs = latency;
+        }
+
+        if (!headless) {
+            char key = cv::waitKey(1);
+            if (key == 'q') {
+                break;
+            }
+        }
+    }
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << "Frames used: " << used << " (" << (elapsed > 0 ? used / elapsed : 0) << " fps)"
+              << ", discarded after overwrite: " << discarded << std::endl;
+    if (used > 0) {
+        std::cout << "Publish-to-read latency: " << latencyMs / used << " ms avg, " << maxLatencyMs << " ms max" << std::endl;
+        if (headless) {
+            std::cout << "Mean brightness: " << brightness / used << std::endl;
+        }
+    }
+    ring.printStats();
+
+    if (!headless) {
+        cv::destroyAllWindows();
+    }
+    return 0;
+}
@@ -0,0 +1,375 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * guidedFilter.cpp
+ * Integral-image box means, the per-window linear fit against the color guide,
+ * and the fused upsample-and-apply pass used for depth refinement.
+ */
+
+#include "guidedFilter.h"
+#include "depthEstimator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+/*
+ * boxMean - Mean of a CV_32FC1 image over a (2r+1) square window clipped to the image
+ * Four lookups in a summed-area table per pixel whatever the radius. The table is kept in
+ * double because products of guide colors summed over a whole frame exhaust float precision.
+ */
+static void boxMean(const cv::Mat &src, cv::Mat &dst, int radius) {
+    const int rows = src.rows;
+    const int cols = src.cols;
+    const int stride = cols + 1;
+
+    thread_local std::vector<double> table;
+    table.assign((size_t)(rows + 1) * stride, 0.0);
+
+    for (int i = 0; i < rows; i++) {
+        const float *s = src.ptr<float>(i);
+        const double *above = table.data() + (size_t)i * stride;
+        double *row = table.data() + (size_t)(i + 1) * stride;
+        double runningSum = 0.0;
+        for (int j = 0; j < cols; j++) {
+            runningSum += s[j];
+            row[j + 1] = above[j + 1] + runningSum;
+        }
+    }
+
+    dst.create(rows, cols, CV_32FC1);
+    for (int i = 0; i < rows; i++) {
+        int top = std::max(i - radius, 0);
+        int bottom = std::min(i + radius + 1, rows);
+        const double *t = table.data() + (size_t)top * stride;
+        const double *b = table.data() + (size_t)bottom * stride;
+        float *d = dst.ptr<float>(i);
+        for (int j = 0; j < cols; j++) {
+            int left = std::max(j - radius, 0);
+            int right = std::min(j + radius + 1, cols);
+            double sum = b[right] - b[left] - t[right] + t[left];
+            d[j] = (float)(sum / ((bottom - top) * (right - left)));
+        }
+    }
+}
+
+/*
+ * guidedCoefficients - Fit q = a . I + b in every window and average the fits
+ * coeffs gets four CV_32FC1 planes: a for blue, green and red, then b, all already box-averaged
+ * so applying them is a per-pixel dot product. Colors and the filtered image are scaled to 0..1.
+ */
+static void guidedCoefficients(const cv::Mat &guide, const cv::Mat &src, int radius, float eps, cv::Mat coeffs[4]) {
+    const int rows = guide.rows;
+    const int cols = guide.cols;
+
+    // Guide channels, input, and the nine products whose window means the fit needs
+    cv::Mat I[3], p;
+    for (int c = 0; c < 3; c++) {
+        I[c].create(rows, cols, CV_32FC1);
+    }
+    p.create(rows, cols, CV_32FC1);
+    for (int i = 0; i < rows; i++) {
+        const unsigned char *g = guide.ptr<unsigned char>(i);
+        const unsigned char *s = src.ptr<unsigned char>(i);
+        float *ib = I[0].ptr<float>(i);
+        float *ig = I[1].ptr<float>(i);
+        float *ir = I[2].ptr<float>(i);
+        float *pr = p.ptr<float>(i);
+        for (int j = 0; j < cols; j++) {
+            ib[j] = g[3 * j] * (1.0f / 255.0f);
+            ig[j] = g[3 * j + 1] * (1.0f / 255.0f);
+            ir[j] = g[3 * j + 2] * (1.0f / 255.0f);
+            pr[j] = s[j] * (1.0f / 255.0f);
+        }
+    }
+
+    // Pair order: bb bg br gg gr rr, then Ib*p Ig*p Ir*p
+    static const int pairA[6] = {0, 0, 0, 1, 1, 2};
+    static const int pairB[6] = {0, 1, 2, 1, 2, 2};
+    cv::Mat meanI[3], meanP, meanII[6], meanIP[3];
+    cv::Mat product(rows, cols, CV_32FC1);
+
+    for (int c = 0; c < 3; c++) {
+        boxMean(I[c], meanI[c], radius);
+    }
+    boxMean(p, meanP, radius);
+    for (int k = 0; k < 9; k++) {
+        const cv::Mat &x = k < 6 ? I[pairA[k]] : I[k - 6];
+        const cv::Mat &y = k < 6 ? I[pairB[k]] : p;
+        for (int i = 0; i < rows; i++) {
+            const float *xr = x.ptr<float>(i);
+            const float *yr = y.ptr<float>(i);
+            float *o = product.ptr<float>(i);
+            for (int j = 0; j < cols; j++) {
+                o[j] = xr[j] * yr[j];
+            }
+        }
+        boxMean(product, k < 6 ? meanII[k] : meanIP[k - 6], radius);
+    }
+
+    // Per window: a = (Sigma + eps I)^-1 cov(I, p), b = mean(p) - a . mean(I)
+    cv::Mat a[3], b;
+    for (int c = 0; c < 3; c++) {
+        a[c].create(rows, cols, CV_32FC1);
+    }
+    b.create(rows, cols, CV_32FC1);
+
+    for (int i = 0; i < rows; i++) {
+        const float *mb = meanI[0].ptr<float>(i);
+        const float *mg = meanI[1].ptr<float>(i);
+        const float *mr = meanI[2].ptr<float>(i);
+        const float *mp = meanP.ptr<float>(i);
+        const float *mii[6], *mip[3];
+        for (int k = 0; k < 6; k++) {
+            mii[k] = meanII[k].ptr<float>(i);
+        }
+        for (int c = 0; c < 3; c++) {
+            mip[c] = meanIP[c].ptr<float>(i);
+        }
+        float *ab = a[0].ptr<float>(i);
+        float *ag = a[1].ptr<float>(i);
+        float *ar = a[2].ptr<float>(i);
+        float *br = b.ptr<float>(i);
+
+        for (int j = 0; j < cols; j++) {
+            float vbb = mii[0][j] - mb[j] * mb[j] + eps;
+            float vbg = mii[1][j] - mb[j] * mg[j];
+            float vbr = mii[2][j] - mb[j] * mr[j];
+            float vgg = mii[3][j] - mg[j] * mg[j] + eps;
+            float vgr = mii[4][j] - mg[j] * mr[j];
+            float vrr = mii[5][j] - mr[j] * mr[j] + eps;
+
+            float cb = mip[0][j] - mb[j] * mp[j];
+            float cg = mip[1][j] - mg[j] * mp[j];
+            float cr = mip[2][j] - mr[j] * mp[j];
+
+            // Symmetric 3x3 inverse by cofactors; eps keeps the determinant away from zero
+            float ibb = vgg * vrr - vgr * vgr;
+            float ibg = vgr * vbr - vbg * vrr;
+            float ibr = vbg * vgr - vgg * vbr;
+            float igg = vbb * vrr - vbr * vbr;
+            float igr = vbg * vbr - vbb * vgr;
+            float irr = vbb * vgg - vbg * vbg;
+            float invDet = 1.0f / (vbb * ibb + vbg * ibg + vbr * ibr);
+
+            ab[j] = (ibb * cb + ibg * cg + ibr * cr) * invDet;
+            ag[j] = (ibg * cb + igg * cg + igr * cr) * invDet;
+            ar[j] = (ibr * cb + igr * cg + irr * cr) * invDet;
+            br[j] = mp[j] - ab[j] * mb[j] - ag[j] * mg[j] - ar[j] * mr[j];
+        }
+    }
+
+    // Every pixel lies in many windows; averaging their fits gives the output coefficients
+    for (int c = 0; c < 3; c++) {
+        boxMean(a[c], coeffs[c], radius);
+    }
+    boxMean(b, coeffs[3], radius);
+}
+
+/*
+ * applyCoefficients - q = a . I + b at the guide's resolution
+ * When the coefficients are smaller than the guide they are bilinearly upsampled on the fly:
+ * they vary slowly, while the sharp structure comes from the full-resolution guide colors.
+ */
+static void applyCoefficients(const cv::Mat coeffs[4], const cv::Mat &guide, cv::Mat &dst) {
+    const int lowRows = coeffs[0].rows;
+    const int lowCols = coeffs[0].cols;
+    float scaleX = (float)lowCols / guide.cols;
+    float scaleY = (float)lowRows / guide.rows;
+
+    // Horizontal neighbours and weights are the same for every row
+    std::vector<int> x0s(guide.cols), x1s(guide.cols);
+    std::vector<float> wxs(guide.cols);
+    for (int j = 0; j < guide.cols; j++) {
+        float fx = (j + 0.5f) * scaleX - 0.5f;
+        int x0 = (int)std::floor(fx);
+        wxs[j] = fx - x0;
+        x0s[j] = std::min(std::max(x0, 0), lowCols - 1);
+        x1s[j] = std::min(std::max(x0 + 1, 0), lowCols - 1);
+    }
+
+    dst.create(guide.rows, guide.cols, CV_8UC1);
+    cv::parallel_for_(cv::Range(0, guide.rows), [&](const cv::Range &range) {
+        // One vertically interpolated coefficient row, interleaved a_b a_g a_r b per column
+        std::vector<float> row((size_t)lowCols * 4);
+
+        for (int i = range.start; i < range.end; i++) {
+            float fy = (i + 0.5f) * scaleY - 0.5f;
+            int y0 = (int)std::floor(fy);
+            float wy = fy - y0;
+            int y1 = std::min(std::max(y0 + 1, 0), lowRows - 1);
+            y0 = std::min(std::max(y0, 0), lowRows - 1);
+
+            for (int c = 0; c < 4; c++) {
+                const float *top = coeffs[c].ptr<float>(y0);
+                const float *bottom = coeffs[c].ptr<float>(y1);
+                for (int x = 0; x < lowCols; x++) {
+                    row[4 * x + c] = top[x] + wy * (bottom[x] - top[x]);
+                }
+            }
+
+            const float *r = row.data();
+            const unsigned char *g = guide.ptr<unsigned char>(i);
+            unsigned char *d = dst.ptr<unsigned char>(i);
+
+            for (int j = 0; j < guide.cols; j++) {
+                const float *left = r + 4 * x0s[j];
+                const float *right = r + 4 * x1s[j];
+                float wx = wxs[j];
+
+                float k[4];
+                for (int c = 0; c < 4; c++) {
+                    k[c] = left[c] + wx * (right[c] - left[c]);
+                }
+
+                // Coefficients were fitted on 0..1 colors and 0..1 output
+                float q = k[0] * g[3 * j] + k[1] * g[3 * j + 1] + k[2] * g[3 * j + 2] + 255.0f * k[3];
+                d[j] = cv::saturate_cast<unsigned char>(q);
+            }
+        }
+    });
+}
+
+/*
+ * guidedFilter - Edge-preserving smoothing of src that follows the edges of guide
+ */
+int guidedFilter(const cv::Mat &guide, const cv::Mat &src, cv::Mat &dst, int radius, float eps) {
+    if (guide.type() != CV_8UC3 || src.type() != CV_8UC1 || guide.size() != src.size() || radius < 1) {
+        return -1;
+    }
+
+    cv::Mat coeffs[4];
+    guidedCoefficients(guide, src, radius, eps, coeffs);
+    applyCoefficients(coeffs, guide, dst);
+    return 0;
+}
+
+/*
+ * guidedDepth - Depth estimated and fitted to the frame at low resolution
+ * The small Gaussian of the scaled estimate stands in for the 31x31 one at full size; the fit
+ * then snaps the smooth map to the subject's outline, and the coefficients are applied to the
+ * full-resolution colors so the edge lands on the right pixel.
+ */
+int guidedDepth(cv::Mat &src, cv::Mat &depth, int scale) {
+    if (src.type() != CV_8UC3 || scale < 1) {
+        return -1;
+    }
+
+    // Frames too small to shrink are refined at full size
+    if (src.rows / scale < 8 || src.cols / scale < 8) {
+        scale = 1;
+    }
+
+    cv::Mat small = src;
+    thread_local cv::Mat depthSmall;
+    if (scale > 1) {
+        cv::resize(src, small, cv::Size(src.cols / scale, src.rows / scale), 0, 0, cv::INTER_AREA);
+    }
+    estimateDepth(small, depthSmall, (31 / scale) | 1);
+
+    // Window of about a sixth of the short side: wide enough to span the blurred outline
+    int radius = std::max(2, std::min(small.rows, small.cols) / 12);
+    cv::Mat coeffs[4];
+    guidedCoefficients(small, depthSmall, radius, 0.01f, coeffs);
+    applyCoefficients(coeffs, src, depth);
+    return 0;
+}
+
+/*
+ * depthEdgeRatio - How much of the depth map's gradient sits on the frame's strongest edges
+ * Mean depth gradient on the top 5% of luma-gradient pixels over the mean everywhere; 1 means
+ * depth edges ignore image edges, higher means they line up.
+ */
+static double depthEdgeRatio(const cv::Mat &frame, const cv::Mat &depth) {
+    cv::Mat gray;
+    cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+
+    std::vector<int> histogram(1021, 0);
+    std::vector<int> lumaGrad((size_t)gray.rows * gray.cols, 0);
+    std::vector<int> depthGrad((size_t)gray.rows * gray.cols, 0);
+    for (int i = 1; i < gray.rows - 1; i++) {
+        for (int j = 1; j < gray.cols - 1; j++) {
+            size_t idx = (size_t)i * gray.cols + j;
+            int gx = gray.ptr<unsigned char>(i)[j + 1] - gray.ptr<unsigned char>(i)[j - 1];
+            int gy = gray.ptr<unsigned char>(i + 1)[j] - gray.ptr<unsigned char>(i - 1)[j];
+            lumaGrad[idx] = std::abs(gx) + std::abs(gy);
+            histogram[lumaGrad[idx]]++;
+            int dx = depth.ptr<unsigned char>(i)[j + 1] - depth.ptr<unsigned char>(i)[j - 1];
+            int dy = depth.ptr<unsigned char>(i + 1)[j] - depth.ptr<unsigned char>(i - 1)[j];
+            depthGrad[idx] = std::abs(dx) + std::abs(dy);
+        }
+    }
+
+    long long interior = (long long)(gray.rows - 2) * (gray.cols - 2);
+    long long count = 0;
+    int threshold = 1020;
+    while (threshold > 0 && count + histogram[threshold] < interior / 20) {
+        count += histogram[threshold];
+        threshold--;
+    }
+
+    double edgeSum = 0.0, allSum = 0.0;
+    long long edgeCount = 0;
+    for (size_t idx = 0; idx < lumaGrad.size(); idx++) {
+        allSum += depthGrad[idx];
+        if (lumaGrad[idx] >= threshold && lumaGrad[idx] > 0) {
+            edgeSum += depthGrad[idx];
+            edgeCount++;
+        }
+    }
+    if (edgeCount == 0 || allSum == 0.0) {
+        return 0.0;
+    }
+    return (edgeSum / edgeCount) / (allSum / interior);
+}
+
+/*
+ * testGuidedDepth - Cost and edge alignment of the guided depth map
+ * Times the full-resolution estimate, its 31x31 Gaussian alone, and the guided version at 1/2
+ * and 1/4, 20 runs each.
+ */
+void testGuidedDepth(cv::Mat &testImage) {
+    const int runs = 20;
+    cv::Mat depth;
+
+    std::cout << "\n=== Guided Depth Refinement ===" << std::endl;
+    std::cout << "Image size: " << testImage.cols << "x" << testImage.rows << std::endl;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < runs; r++) {
+        estimateDepth(testImage, depth);
+    }
+    double fullMs = elapsedMs(start) / runs;
+    double fullRatio = depthEdgeRatio(testImage, depth);
+
+    cv::Mat blurred;
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < runs; r++) {
+        cv::GaussianBlur(depth, blurred, cv::Size(31, 31), 0);
+    }
+    double gaussianMs = elapsedMs(start) / runs;
+
+    std::cout << "estimateDepth full: " << fullMs << " ms (31x31 Gaussian alone " << gaussianMs
+              << " ms), edge ratio " << fullRatio << std::endl;
+
+    int scales[2] = {2, 4};
+    for (int s = 0; s < 2; s++) {
+        start = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < runs; r++) {
+            guidedDepth(testImage, depth, scales[s]);
+        }
+        double guidedMs = elapsedMs(start) / runs;
+        std::cout << "guided 1/" << scales[s] << ": " << guidedMs << " ms (" << fullMs / guidedMs
+                  << "x), edge ratio " << depthEdgeRatio(testImage, depth) << std::endl;
+    }
+    std::cout << "===============================\n" << std::endl;
+}
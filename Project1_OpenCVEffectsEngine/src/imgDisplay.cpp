@@ -7,18 +7,215 @@
  * imgDisplay.cpp
  * Loads and displays a single image file with basic keyboard controls.
  * Warmup program to familiarize with OpenCV image loading and display functions.
+ * With --tiles, very large images are viewed through a tile pyramid instead of
+ * being loaded whole.
  */
 
 #include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <functional>
 #include <iostream>
 #include <string>
+#include "filters.h"
+#include "tilePyramid.h"
+
+// Tiled viewer window size
+static const int viewWidth = 1280;
+static const int viewHeight = 800;
+
+/*
+ * viewerFilter - Filter bound to a viewer key, with the border pixels it reads past each edge
+ * Filters that produce gradients are converted back to displayable 8UC3 here.
+ */
+static bool viewerFilter(char key, std::function<int(cv::Mat &, cv::Mat &)> &filter, int &halo, std::string &name) {
+    switch (key) {
+    case 'h':
+        filter = [](cv::Mat &src, cv::Mat &dst) { return greyscale(src, dst); };
+        halo = 0;
+        name = "Greyscale";
+        return true;
+    case 'p':
+        filter = [](cv::Mat &src, cv::Mat &dst) { return sepia(src, dst); };
+        halo = 0;
+        name = "Sepia";
+        return true;
+    case 'b':
+        filter = [](cv::Mat &src, cv::Mat &dst) { return blur5x5_2(src, dst); };
+        halo = 2;
+        name = "Blur (5x5)";
+        return true;
+    case 'x':
+    case 'y':
+        filter = [key](cv::Mat &src, cv::Mat &dst) {
+            cv::Mat sobel;
+            int result = (key == 'x') ? sobelX3x3(src, sobel) : sobelY3x3(src, sobel);
+            cv::convertScaleAbs(sobel, dst);
+            return result;
+        };
+        halo = 1;
+        name = (key == 'x') ? "Sobel X" : "Sobel Y";
+        return true;
+    case 'm':
+        filter = [](cv::Mat &src, cv::Mat &dst) {
+            cv::Mat sobelX, sobelY;
+            sobelX3x3(src, sobelX);
+            sobelY3x3(src, sobelY);
+            return magnitude(sobelX, sobelY, dst, MAGNITUDE_INT_SQRT);
+        };
+        halo = 1;
+        name = "Gradient Magnitude";
+        return true;
+    case 'l':
+        filter = [](cv::Mat &src, cv::Mat &dst) { return blurQuantize(src, dst, 10); };
+        halo = 2;
+        name = "Blur Quantize";
+        return true;
+    case 'k':
+        filter = [](cv::Mat &src, cv::Mat &dst) { return sketchFilter(src, dst); };
+        halo = 1;
+        name = "Sketch";
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*
+ * runTileViewer - Pan and zoom a very large image through its tile pyramid
+ * Only the tiles under the window are decoded, and filters run on the visible pixels only,
+ * so memory and redraw time depend on the window, not on the image.
+ */
+static int runTileViewer(const std::string &imagePath, const std::string &cachePath) {
+    TilePyramid pyramid;
+    if (pyramid.open(imagePath, cachePath) != 0) {
+        std::cout << "ERROR: Could not open tile pyramid for " << imagePath << std::endl;
+        return -1;
+    }
+
+    cv::Size full = pyramid.levelSize(0);
+    std::cout << "Size: " << full.width << "x" << full.height << " (" << pyramid.levelCount() << " levels)" << std::endl;
+    std::cout << "\nControls:" << std::endl;
+    std::cout << "  q - Quit" << std::endl;
+    std::cout << "  w / a / s / d - Pan up/left/down/right" << std::endl;
+    std::cout << "  + / - - Zoom in/out" << std::endl;
+    std::cout << "  0 - Fit image, 1 - Actual pixels" << std::endl;
+    std::cout << "  h p b x y m l k - Greyscale, sepia, blur, Sobel X/Y, magnitude, blur quantize, sketch (again to clear)" << std::endl;
+    std::cout << "  i - Show view and tile cache info" << std::endl;
+    std::cout << "  v - Save current view" << std::endl;
+
+    double fitZoom = std::min((double)viewWidth / full.width, (double)viewHeight / full.height);
+    double zoom = fitZoom;
+    double centerX = full.width / 2.0;
+    double centerY = full.height / 2.0;
+
+    std::function<int(cv::Mat &, cv::Mat &)> filter;
+    int halo = 0;
+    char filterKey = 0;
+    std::string filterName = "None";
+
+    cv::namedWindow("Image Display", cv::WINDOW_AUTOSIZE);
+    cv::Mat view;
+
+    while (true) {
+        int level = pyramid.render(centerX, centerY, zoom, cv::Size(viewWidth, viewHeight), filter, halo, view);
+
+        char status[128];
+        snprintf(status, sizeof(status), "Zoom %.1f%%  Level %d  Filter: %s", zoom * 100.0, level, filterName.c_str());
+        cv::putText(view, status, cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(0, 255, 0), 2);
+        cv::imshow("Image Display", view);
+
+        char key = cv::waitKey(0);
+
+        // A quarter of the window per pan step, whatever the zoom
+        double step = viewWidth / 4.0 / zoom;
+        std::function<int(cv::Mat &, cv::Mat &)> selected;
+        int selectedHalo = 0;
+        std::string selectedName;
+
+        if (key == 'q') {
+            std::cout << "Quitting..." << std::endl;
+            break;
+        }
+        else if (key == 'a' || key == 'd') {
+            centerX += (key == 'a') ? -step : step;
+        }
+        else if (key == 'w' || key == 's') {
+            centerY += (key == 'w') ? -step : step;
+        }
+        else if (key == '+' || key == '=') {
+            zoom = std::min(zoom * 1.25, 8.0);
+        }
+        else if (key == '-') {
+            zoom = std::max(zoom / 1.25, fitZoom / 4.0);
+        }
+        else if (key == '0') {
+            zoom = fitZoom;
+            centerX = full.width / 2.0;
+            centerY = full.height / 2.0;
+        }
+        else if (key == '1') {
+            zoom = 1.0;
+        }
+        else if (viewerFilter(key, selected, selectedHalo, selectedName)) {
+            if (key == filterKey) {
+                filter = nullptr;
+                halo = 0;
+                filterKey = 0;
+                filterName = "None";
+            } else {
+                filter = selected;
+                halo = selectedHalo;
+                filterKey = key;
+                filterName = selectedName;
+            }
+        }
+        else if (key == 'i') {
+            std::cout << "\n--- View Information ---" << std::endl;
+            std::cout << "Center: " << centerX << ", " << centerY << "  Zoom: " << zoom * 100.0 << "%  Level: " << level << std::endl;
+            std::cout << "Decoded tiles held: " << pyramid.residentTiles() << " ("
+                      << pyramid.residentMemory() / (1024 * 1024.0) << " MB)" << std::endl;
+        }
+        else if (key == 'v') {
+            std::string savePath = "../data/saved_view.jpg";
+            cv::imwrite(savePath, view);
+            std::cout << "Saved to: " << savePath << std::endl;
+        }
+
+        // Keep the centre over the image
+        centerX = std::min(std::max(centerX, 0.0), (double)full.width);
+        centerY = std::min(std::max(centerY, 0.0), (double)full.height);
+    }
+
+    pyramid.printStats();
+    cv::destroyAllWindows();
+    return 0;
+}
 
 int main(int argc, char** argv) {
     std::string imagePath = "../data/test_image.jpg";
+    std::string cachePath;
+    bool tiled = false;
     
-    // Accept image path from command line if provided
-    if (argc > 1) {
-        imagePath = argv[1];
+    // Accept image path from command line if provided; --tiles [--cache path] opens the tiled viewer
+    for (int a = 1; a < argc; a++) {
+        std::string arg = argv[a];
+        if (arg == "--tiles") {
+            tiled = true;
+        }
+        else if (arg == "--cache" && a + 1 < argc) {
+            cachePath = argv[++a];
+        }
+        else {
+            imagePath = arg;
+        }
+    }
+    
+    if (tiled) {
+        if (cachePath.empty()) {
+            cachePath = imagePath + ".pyr";
+        }
+        return runTileViewer(imagePath, cachePath);
     }
     
     cv::Mat image = cv::imread(imagePath);
@@ -26,7 +223,7 @@ int main(int argc, char** argv) {
     // Verify image loaded successfully
     if (image.empty()) {
         std::cout << "ERROR: Could not load image: " << imagePath << std::endl;
-        std::cout << "Usage: " << argv[0] << " [image_path]" << std::endl;
+        std::cout << "Usage: " << argv[0] << " [image_path] [--tiles [--cache path]]" << std::endl;
         return -1;
     }
 
@@ -0,0 +1,363 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * mjpegServer.cpp
+ * Loopback listener, JPEG encoder pool and per-client multipart senders.
+ */
+
+#include "mjpegServer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// Multipart boundary between JPEGs
+static const char *boundary = "frame";
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+#ifndef _WIN32
+/*
+ * sendAll - Write the whole buffer, retrying short writes; false once the client is gone
+ */
+static bool sendAll(int fd, const void *data, size_t length) {
+    const char *bytes = (const char *)data;
+    while (length > 0) {
+        ssize_t n = send(fd, bytes, length, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        bytes += n;
+        length -= (size_t)n;
+    }
+    return true;
+}
+
+/*
+ * configureClient - Small send buffer and send/receive timeouts for a viewer socket
+ * With the default (multi-megabyte) loopback buffer a slow viewer would queue seconds of stale
+ * JPEGs in the kernel; a small one makes send() block instead, so the sender skips to the newest.
+ * A viewer that stops reading for the timeout is disconnected.
+ */
+static void configureClient(int fd) {
+    int sendBuffer = 128 * 1024;
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+
+    struct timeval timeout;
+    timeout.tv_sec = 2;
+    timeout.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+#endif
+
+MjpegServer::MjpegServer()
+    : listenFd(-1), previewWidth(0), jpegQuality(70), stopping(false), pendingFull(false),
+      submitted(0), pendingSeq(0), latestSeq(0), jpegsPublished(0), clientCount(0), overwritten(0),
+      encoded(0), encodeMs(0), clientsServed(0), framesSent(0), framesDropped(0) {}
+
+MjpegServer::~MjpegServer() {
+    stop();
+}
+
+bool MjpegServer::start(int port, int width, int quality, int encoderThreads) {
+#ifndef _WIN32
+    stop();
+
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cout << "Error creating preview socket: " << strerror(errno) << std::endl;
+        return false;
+    }
+    int reuse = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    // Loopback only; the preview is for the operator on this machine
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons((unsigned short)port);
+    if (bind(listenFd, (struct sockaddr *)&address, sizeof(address)) != 0 || listen(listenFd, 4) != 0) {
+        std::cout << "Error: cannot listen on 127.0.0.1:" << port << ": " << strerror(errno) << std::endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+
+    previewWidth = std::max(0, width);
+    jpegQuality = std::min(100, std::max(1, quality));
+    stopping = false;
+    for (int i = 0; i < std::max(1, encoderThreads); i++) {
+        encoders.emplace_back(&MjpegServer::encodeLoop, this);
+    }
+    acceptor = std::thread(&MjpegServer::acceptLoop, this);
+    return true;
+#else
+    (void)port; (void)width; (void)quality; (void)encoderThreads;
+    std::cout << "Error: the MJPEG preview needs POSIX sockets" << std::endl;
+    return false;
+#endif
+}
+
+/*
+ * submit - Make frame the pending frame for the encoders
+ * A pending frame no encoder has taken yet is simply replaced, so the render loop never
+ * waits on encoding. Buffers circulate between submit and the encoders, so the copy does not
+ * allocate once the sizes settle.
+ */
+void MjpegServer::submit(const cv::Mat &frame) {
+    if (listenFd < 0 || clientCount == 0 || frame.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (pendingFull) {
+            overwritten++;
+        }
+        frame.copyTo(pending);
+        pendingFull = true;
+        pendingSeq = ++submitted;
+    }
+    frameWaiting.notify_one();
+}
+
+void MjpegServer::encodeLoop() {
+    cv::Mat work;
+    cv::Mat small;
+    std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, jpegQuality};
+
+    for (;;) {
+        unsigned long long seq;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            frameWaiting.wait(guard, [&] { return stopping || pendingFull; });
+            if (stopping) {
+                return;
+            }
+            cv::swap(work, pending);
+            pendingFull = false;
+            seq = pendingSeq;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        const cv::Mat *source = &work;
+        if (previewWidth > 0 && work.cols != previewWidth) {
+            int height = std::max(1, work.rows * previewWidth / work.cols);
+            cv::resize(work, small, cv::Size(previewWidth, height), 0, 0, cv::INTER_AREA);
+            source = &small;
+        }
+        std::shared_ptr<std::vector<uchar>> jpeg = std::make_shared<std::vector<uchar>>();
+        cv::imencode(".jpg", *source, *jpeg, params);
+        double ms = elapsedMs(start);
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            encoded++;
+            encodeMs += ms;
+            // Encoders finish out of order; an older frame never replaces a newer one
+            if (seq > latestSeq) {
+                latestSeq = seq;
+                latestJpeg = jpeg;
+                jpegsPublished++;
+            }
+        }
+        jpegReady.notify_all();
+    }
+}
+
+/*
+ * sendLoop - Answer the request, then send each newest JPEG this client has not had yet
+ * The request is read here rather than in acceptLoop, so a client that connects and never sends
+ * one only holds up its own thread. It is read and ignored, so any path works. JPEGs published
+ * while the previous send was in progress are skipped for this client only.
+ */
+void MjpegServer::sendLoop(Client *client) {
+#ifndef _WIN32
+    // Read up to the end of the request headers, or until the receive timeout
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+        ssize_t n = recv(client->fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            break;
+        }
+        request.append(buffer, (size_t)n);
+    }
+
+    std::string response = std::string("HTTP/1.0 200 OK\r\n") +
+                           "Content-Type: multipart/x-mixed-replace; boundary=" + boundary + "\r\n" +
+                           "Cache-Control: no-cache\r\nConnection: close\r\n\r\n";
+    if (!sendAll(client->fd, response.data(), response.size())) {
+        client->done = true;
+        return;
+    }
+
+    // Only now a viewer, so submit() starts handing frames to the encoders. latestJpeg may be
+    // left over from a viewer that disconnected long ago, so wait for one published after this.
+    clientCount++;
+    unsigned long long lastSent;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        lastSent = jpegsPublished;
+    }
+
+    for (;;) {
+        std::shared_ptr<const std::vector<uchar>> jpeg;
+        unsigned long long index;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            jpegReady.wait(guard, [&] { return stopping || (latestJpeg && jpegsPublished > lastSent); });
+            if (stopping) {
+                break;
+            }
+            jpeg = latestJpeg;
+            index = jpegsPublished;
+        }
+
+        if (index > lastSent + 1) {
+            client->dropped += (long long)(index - lastSent - 1);
+        }
+        lastSent = index;
+
+        char partHeader[128];
+        int headerLength = snprintf(partHeader, sizeof(partHeader),
+                                    "--%s\r\nContent-Type: image/jpeg\r\nContent-Length: %zu\r\n\r\n",
+                                    boundary, jpeg->size());
+        if (!sendAll(client->fd, partHeader, headerLength) ||
+            !sendAll(client->fd, jpeg->data(), jpeg->size()) ||
+            !sendAll(client->fd, "\r\n", 2)) {
+            break;
+        }
+        client->sent++;
+    }
+#endif
+    clientCount--;
+    client->done = true;
+}
+
+/*
+ * acceptLoop - Give every connection on the port its own sender thread
+ * Nothing here waits on the client, so one that never sends a request cannot stall the others.
+ */
+void MjpegServer::acceptLoop() {
+#ifndef _WIN32
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (stopping) {
+                return;
+            }
+        }
+        reapClients(false);
+
+        struct pollfd waiting;
+        waiting.fd = listenFd;
+        waiting.events = POLLIN;
+        if (poll(&waiting, 1, 200) <= 0) {
+            continue;
+        }
+
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        configureClient(fd);
+
+        std::unique_ptr<Client> client(new Client());
+        client->fd = fd;
+        client->sender = std::thread(&MjpegServer::sendLoop, this, client.get());
+        clients.push_back(std::move(client));
+        clientsServed++;
+    }
+#endif
+}
+
+/*
+ * reapClients - Join finished senders (or all of them) and fold their counts into the totals
+ */
+void MjpegServer::reapClients(bool all) {
+#ifndef _WIN32
+    for (size_t i = 0; i < clients.size();) {
+        Client &client = *clients[i];
+        if (!all && !client.done) {
+            i++;
+            continue;
+        }
+        client.sender.join();
+        close(client.fd);
+        framesSent += client.sent;
+        framesDropped += client.dropped;
+        clients.erase(clients.begin() + i);
+    }
+#else
+    (void)all;
+#endif
+}
+
+void MjpegServer::stop() {
+    if (listenFd < 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    frameWaiting.notify_all();
+    jpegReady.notify_all();
+
+    if (acceptor.joinable()) {
+        acceptor.join();
+    }
+    for (size_t i = 0; i < encoders.size(); i++) {
+        encoders[i].join();
+    }
+    encoders.clear();
+
+#ifndef _WIN32
+    // Unblock senders stuck in send() to a viewer that stopped reading
+    for (size_t i = 0; i < clients.size(); i++) {
+        shutdown(clients[i]->fd, SHUT_RDWR);
+    }
+    reapClients(true);
+    close(listenFd);
+#endif
+    listenFd = -1;
+}
+
+void MjpegServer::printStats() const {
+    if (encoded == 0 && clientsServed == 0) {
+        return;
+    }
+
+    std::cout << "MJPEG preview: " << clientsServed << " clients, " << encoded << " frames encoded ("
+              << (encoded ? encodeMs / encoded : 0) << " ms each), " << overwritten
+              << " replaced before encoding" << std::endl;
+    std::cout << "  Frames sent: " << framesSent << ", skipped for slow clients: " << framesDropped << std::endl;
+}
@@ -0,0 +1,165 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * overlay.cpp
+ * Premultiplied-alpha overlay conversion, size-bucketed caching and compositing.
+ */
+
+#include "overlay.h"
+#include <iostream>
+
+// Exact round(v / 255) for v in [0, 255 * 255]
+static inline unsigned int div255(unsigned int v) {
+    v += 128;
+    return (v + (v >> 8)) >> 8;
+}
+
+/*
+ * premultiplyOverlay - Convert an overlay to premultiplied BGRA
+ * Folding the alpha threshold into the alpha channel lets compositing run without branches.
+ */
+int premultiplyOverlay(const cv::Mat &src, cv::Mat &dst, int minAlpha, int keyThreshold, int keyAlpha) {
+    if (src.depth() != CV_8U || (src.channels() != 3 && src.channels() != 4)) {
+        return -1;
+    }
+
+    int channels = src.channels();
+    cv::Mat out(src.rows, src.cols, CV_8UC4);
+
+    for (int i = 0; i < src.rows; i++) {
+        const unsigned char *srcRow = src.ptr<unsigned char>(i);
+        unsigned char *outRow = out.ptr<unsigned char>(i);
+
+        for (int j = 0; j < src.cols; j++) {
+            const unsigned char *p = srcRow + j * channels;
+            unsigned int alpha;
+            if (channels == 4) {
+                alpha = (p[3] >= minAlpha) ? p[3] : 0;
+            } else {
+                alpha = (p[0] + p[1] + p[2] > keyThreshold) ? keyAlpha : 0;
+            }
+
+            outRow[4 * j] = (unsigned char)div255(p[0] * alpha);
+            outRow[4 * j + 1] = (unsigned char)div255(p[1] * alpha);
+            outRow[4 * j + 2] = (unsigned char)div255(p[2] * alpha);
+            outRow[4 * j + 3] = (unsigned char)alpha;
+        }
+    }
+
+    dst = out;
+    return 0;
+}
+
+/*
+ * compositeOverlay - dst = overlay + dst * (1 - alpha)
+ * The destination rectangle is clipped once, so the inner loop has no bounds checks.
+ */
+int compositeOverlay(cv::Mat &dst, const cv::Mat &overlay, cv::Point topLeft) {
+    if (dst.type() != CV_8UC3 || overlay.type() != CV_8UC4) {
+        return -1;
+    }
+
+    cv::Rect placed(topLeft.x, topLeft.y, overlay.cols, overlay.rows);
+    cv::Rect clipped = placed & cv::Rect(0, 0, dst.cols, dst.rows);
+    if (clipped.empty()) {
+        return 0;
+    }
+
+    int offsetX = clipped.x - placed.x;
+    int offsetY = clipped.y - placed.y;
+
+    for (int y = 0; y < clipped.height; y++) {
+        const unsigned char *ovRow = overlay.ptr<unsigned char>(offsetY + y) + 4 * offsetX;
+        unsigned char *dstRow = dst.ptr<unsigned char>(clipped.y + y) + 3 * clipped.x;
+
+        for (int x = 0; x < clipped.width; x++) {
+            unsigned int inverse = 255 - ovRow[4 * x + 3];
+            dstRow[3 * x] = (unsigned char)(ovRow[4 * x] + div255(dstRow[3 * x] * inverse));
+            dstRow[3 * x + 1] = (unsigned char)(ovRow[4 * x + 1] + div255(dstRow[3 * x + 1] * inverse));
+            dstRow[3 * x + 2] = (unsigned char)(ovRow[4 * x + 2] + div255(dstRow[3 * x + 2] * inverse));
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * get - Look up size, rendering and storing it on a miss
+ * Emptying the whole map when it fills is cheaper than tracking use, and the sizes still in
+ * play are rebuilt within a frame or two.
+ */
+cv::Mat SizeCache::get(cv::Size size, const std::function<cv::Mat(cv::Size)> &render) {
+    std::pair<int, int> key(size.width, size.height);
+    std::map<std::pair<int, int>, cv::Mat>::iterator it = entries.find(key);
+    if (it != entries.end()) {
+        return it->second;
+    }
+
+    if (entries.size() >= capacity) {
+        entries.clear();
+    }
+    cv::Mat image = render(size);
+    entries[key] = image;
+    return image;
+}
+
+// A BGRA mask over a large head is up to about 700 KB, so 32 buckets bound the cache near 22 MB
+OverlayCache::OverlayCache(int bucket) : bucket(std::max(bucket, 1)), scaled(32) {}
+
+bool OverlayCache::load(const std::string &path) {
+    cv::Mat image = cv::imread(path, cv::IMREAD_UNCHANGED);
+    if (image.empty()) {
+        return false;
+    }
+
+    // 16-bit or grayscale files go through a plain color read
+    if (image.depth() != CV_8U || (image.channels() != 3 && image.channels() != 4)) {
+        image = cv::imread(path);
+    }
+
+    set(image);
+    return !base.empty();
+}
+
+void OverlayCache::set(const cv::Mat &image) {
+    std::lock_guard<std::mutex> guard(lock);
+    scaled.clear();
+    if (premultiplyOverlay(image, base) != 0) {
+        base.release();
+    }
+}
+
+/*
+ * get - Resized overlay for the nearest size bucket
+ * Resizing the premultiplied image keeps transparent edges from bleeding dark fringes.
+ */
+cv::Mat OverlayCache::get(cv::Size size) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (base.empty()) {
+        return cv::Mat();
+    }
+
+    int w = std::max(bucket, ((size.width + bucket / 2) / bucket) * bucket);
+    int h = std::max(bucket, ((size.height + bucket / 2) / bucket) * bucket);
+
+    return scaled.get(cv::Size(w, h), [this](cv::Size bucketSize) {
+        cv::Mat resized;
+        cv::resize(base, resized, bucketSize, 0, 0, cv::INTER_AREA);
+        return resized;
+    });
+}
+
+int OverlayCache::draw(cv::Mat &dst, cv::Rect target) {
+    cv::Mat sprite = get(target.size());
+    if (sprite.empty()) {
+        return -1;
+    }
+
+    cv::Point topLeft(target.x + (target.width - sprite.cols) / 2,
+                      target.y + (target.height - sprite.rows) / 2);
+    return compositeOverlay(dst, sprite, topLeft);
+}
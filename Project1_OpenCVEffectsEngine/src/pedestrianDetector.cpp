@@ -0,0 +1,294 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * pedestrianDetector.cpp
+ * Parallel HOG pyramid scan on detect frames, template tracking in between.
+ */
+
+#include "pedestrianDetector.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+// Size of the default people detector's window
+static const int windowWidth = 64;
+static const int windowHeight = 128;
+
+// HOG block stride; strips start on multiples of it so they see the same windows as a full scan
+static const int windowStride = 8;
+
+// HOG cell size; strips read one cell past their windows so no window sits on a strip edge
+static const int cellSize = 8;
+
+// Below this normalized correlation a tracked person counts as lost until the next detection
+static const double minMatchScore = 0.4;
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+static double overlap(const cv::Rect &a, const cv::Rect &b) {
+    double inter = (a & b).area();
+    double uni = a.area() + b.area() - inter;
+    return uni > 0 ? inter / uni : 0.0;
+}
+
+PedestrianDetector::PedestrianDetector(int minPersonHeight, int detectInterval, int maxLevels, double levelStep)
+    : minPersonHeight(std::max(minPersonHeight, windowHeight / 2)), detectInterval(std::max(1, detectInterval)),
+      maxLevels(std::max(1, maxLevels)), levelStep(std::max(levelStep, 1.05)), baseScale(1.0), nextId(0),
+      framesSinceDetect(0), frames(0), detectFrames(0), detectionsFound(0), boxesReported(0),
+      totalMs(0), detectMs(0), trackMs(0) {
+    hog.setSVMDetector(cv::HOGDescriptor::getDefaultPeopleDetector());
+    // The first frame always runs the detector
+    framesSinceDetect = this->detectInterval;
+}
+
+/*
+ * runDetector - Single-scale HOG over every pyramid level, in parallel
+ * Each level is cut into column strips of roughly the smallest level's area so the big levels do
+ * not leave the other threads idle. Strips overlap by one window and split the window origins
+ * between them. Each strip is also padded by one HOG cell on both sides and hits found in the
+ * padding are dropped, so gradients next to a strip cut come from real neighbouring pixels
+ * rather than border extrapolation, and every window is scored as in a full-level scan.
+ */
+void PedestrianDetector::runDetector(std::vector<cv::Rect> &found, std::vector<double> &weights) {
+    struct Job {
+        int level;
+        int x0;     // first window origin
+        int x1;     // one past the last window origin
+    };
+
+    std::vector<double> levelScales;
+    double scale = 1.0;
+    while ((int)levelScales.size() < maxLevels &&
+           base.rows / scale >= windowHeight && base.cols / scale >= windowWidth) {
+        levelScales.push_back(scale);
+        scale *= levelStep;
+    }
+    if (levelScales.empty()) {
+        return;
+    }
+
+    pyramid.resize(levelScales.size());
+    pyramid[0] = base;
+    for (size_t l = 1; l < levelScales.size(); l++) {
+        cv::Size size((int)(base.cols / levelScales[l]), (int)(base.rows / levelScales[l]));
+        cv::resize(base, pyramid[l], size, 0, 0, cv::INTER_AREA);
+    }
+
+    double targetArea = pyramid.back().total();
+    std::vector<Job> jobs;
+    for (size_t l = 0; l < pyramid.size(); l++) {
+        int origins = (pyramid[l].cols - windowWidth) / windowStride + 1;
+        int strips = std::max(1, std::min((int)(pyramid[l].total() / targetArea + 0.5), origins));
+        for (int s = 0; s < strips; s++) {
+            jobs.push_back({(int)l, origins * s / strips * windowStride, origins * (s + 1) / strips * windowStride});
+        }
+    }
+
+    std::vector<std::vector<cv::Rect>> jobFound(jobs.size());
+    std::vector<std::vector<double>> jobWeights(jobs.size());
+
+    cv::parallel_for_(cv::Range(0, (int)jobs.size()), [&](const cv::Range &range) {
+        for (int j = range.start; j < range.end; j++) {
+            const Job &job = jobs[j];
+            const cv::Mat &level = pyramid[job.level];
+            // The left pad is one cell (a multiple of the stride) or nothing, so origins stay on the full-scan grid
+            int stripX = job.x0 >= cellSize ? job.x0 - cellSize : 0;
+            int x1 = std::min(level.cols, job.x1 - windowStride + windowWidth + cellSize);
+            cv::Mat strip = level(cv::Rect(stripX, 0, x1 - stripX, level.rows));
+
+            std::vector<cv::Point> hits;
+            std::vector<double> hitWeights;
+            hog.detect(strip, hits, hitWeights, 0, cv::Size(windowStride, windowStride), cv::Size(0, 0));
+
+            // Level pixels back to frame pixels
+            double toFrame = levelScales[job.level] / baseScale;
+            for (size_t h = 0; h < hits.size(); h++) {
+                int x = stripX + hits[h].x;
+                if (x < job.x0 || x >= job.x1) {
+                    continue;
+                }
+                jobFound[j].push_back(cv::Rect((int)(x * toFrame), (int)(hits[h].y * toFrame),
+                                               (int)(windowWidth * toFrame), (int)(windowHeight * toFrame)));
+                jobWeights[j].push_back(h < hitWeights.size() ? hitWeights[h] : 0.0);
+            }
+        }
+    });
+
+    for (size_t j = 0; j < jobs.size(); j++) {
+        found.insert(found.end(), jobFound[j].begin(), jobFound[j].end());
+        weights.insert(weights.end(), jobWeights[j].begin(), jobWeights[j].end());
+    }
+
+    // Merge the hits of one person across neighbouring windows and levels
+    hog.groupRectangles(found, weights, 1, 0.2);
+}
+
+/*
+ * updateTracks - Match fresh detections to existing tracks by overlap
+ * Matched people keep their id; unmatched detections start new tracks and tracks the detector
+ * no longer sees are dropped. Every template is re-cut from the current frame.
+ */
+void PedestrianDetector::updateTracks(const std::vector<cv::Rect> &found, const std::vector<double> &weights) {
+    struct Pair {
+        double iou;
+        size_t track;
+        size_t detection;
+    };
+
+    std::vector<Pair> pairs;
+    for (size_t t = 0; t < tracks.size(); t++) {
+        for (size_t d = 0; d < found.size(); d++) {
+            double iou = overlap(tracks[t].person.box, found[d]);
+            if (iou > 0.3) {
+                pairs.push_back({iou, t, d});
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end(), [](const Pair &a, const Pair &b) { return a.iou > b.iou; });
+
+    std::vector<int> trackFor(found.size(), -1);
+    std::vector<bool> trackUsed(tracks.size(), false);
+    for (size_t p = 0; p < pairs.size(); p++) {
+        if (!trackUsed[pairs[p].track] && trackFor[pairs[p].detection] < 0) {
+            trackUsed[pairs[p].track] = true;
+            trackFor[pairs[p].detection] = (int)pairs[p].track;
+        }
+    }
+
+    std::vector<Track> updated;
+    cv::Rect bounds(0, 0, base.cols, base.rows);
+    for (size_t d = 0; d < found.size(); d++) {
+        Track track;
+        track.person.id = (trackFor[d] >= 0) ? tracks[trackFor[d]].person.id : nextId++;
+        track.person.box = found[d];
+        track.person.score = (float)(d < weights.size() ? weights[d] : 0.0);
+
+        const cv::Rect &box = found[d];
+        track.baseBox = cv::Rect((int)(box.x * baseScale), (int)(box.y * baseScale),
+                                 (int)(box.width * baseScale), (int)(box.height * baseScale)) & bounds;
+        if (track.baseBox.width < 8 || track.baseBox.height < 8) {
+            continue;
+        }
+        track.templ = base(track.baseBox).clone();
+        updated.push_back(track);
+    }
+    tracks.swap(updated);
+}
+
+/*
+ * followTracks - Move every track to its best template match near its last position
+ */
+void PedestrianDetector::followTracks() {
+    cv::Rect bounds(0, 0, base.cols, base.rows);
+
+    cv::parallel_for_(cv::Range(0, (int)tracks.size()), [&](const cv::Range &range) {
+        for (int t = range.start; t < range.end; t++) {
+            Track &track = tracks[t];
+            const cv::Rect &box = track.baseBox;
+
+            // People move mostly sideways between frames
+            int padX = std::max(8, box.width / 4);
+            int padY = std::max(4, box.height / 8);
+            cv::Rect search = cv::Rect(box.x - padX, box.y - padY, box.width + 2 * padX, box.height + 2 * padY) & bounds;
+            if (search.width < track.templ.cols || search.height < track.templ.rows) {
+                track.person.score = -1;
+                continue;
+            }
+
+            cv::Mat result;
+            cv::matchTemplate(base(search), track.templ, result, cv::TM_CCOEFF_NORMED);
+            double best = 0;
+            cv::Point bestLoc;
+            cv::minMaxLoc(result, nullptr, &best, nullptr, &bestLoc);
+
+            if (best < minMatchScore) {
+                track.person.score = -1;
+                continue;
+            }
+
+            track.baseBox.x = search.x + bestLoc.x;
+            track.baseBox.y = search.y + bestLoc.y;
+            track.person.box = cv::Rect((int)(track.baseBox.x / baseScale), (int)(track.baseBox.y / baseScale),
+                                        track.person.box.width, track.person.box.height);
+            track.person.score = (float)best;
+        }
+    });
+
+    tracks.erase(std::remove_if(tracks.begin(), tracks.end(),
+                                [](const Track &track) { return track.person.score < 0; }),
+                 tracks.end());
+}
+
+int PedestrianDetector::process(cv::Mat &frame, std::vector<TrackedPerson> &people) {
+    people.clear();
+    if (frame.empty() || frame.type() != CV_8UC3) {
+        return -1;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    if (frames == 0) {
+        firstProcess = std::chrono::steady_clock::now();
+    }
+
+    // A person of minPersonHeight pixels fills the detector window at the base scale
+    baseScale = std::min(1.0, (double)windowHeight / minPersonHeight);
+    cv::Size baseSize((int)(frame.cols * baseScale + 0.5), (int)(frame.rows * baseScale + 0.5));
+    cv::resize(frame, smallColor, baseSize, 0, 0, cv::INTER_AREA);
+    cv::cvtColor(smallColor, base, cv::COLOR_BGR2GRAY);
+
+    framesSinceDetect++;
+    bool detectNow = framesSinceDetect >= detectInterval;
+
+    if (detectNow) {
+        framesSinceDetect = 0;
+        std::vector<cv::Rect> found;
+        std::vector<double> weights;
+        runDetector(found, weights);
+        updateTracks(found, weights);
+        detectionsFound += found.size();
+        detectFrames++;
+    } else {
+        followTracks();
+    }
+
+    for (size_t t = 0; t < tracks.size(); t++) {
+        people.push_back(tracks[t].person);
+    }
+
+    double ms = elapsedMs(start);
+    totalMs += ms;
+    if (detectNow) {
+        detectMs += ms;
+    } else {
+        trackMs += ms;
+    }
+    frames++;
+    boxesReported += people.size();
+    lastProcess = std::chrono::steady_clock::now();
+
+    return (int)people.size();
+}
+
+void PedestrianDetector::printStats() const {
+    if (frames == 0) {
+        return;
+    }
+
+    // Throughput over wall time, so time the loop spends on anything else counts against it
+    long long trackFrames = frames - detectFrames;
+    double seconds = std::chrono::duration_cast<std::chrono::microseconds>(lastProcess - firstProcess).count() / 1e6;
+    std::cout << "Pedestrian detection over " << frames << " frames: " << totalMs / frames << " ms/frame";
+    if (seconds > 0) {
+        std::cout << ", " << detectionsFound / seconds << " detections/s over " << seconds << " s";
+    }
+    std::cout << std::endl;
+    std::cout << "  Detect frames: " << detectFrames << " (" << (detectFrames ? detectMs / detectFrames : 0) << " ms)"
+              << ", track frames: " << trackFrames << " (" << (trackFrames ? trackMs / trackFrames : 0) << " ms)"
+              << ", people/frame: " << (double)boxesReported / frames << ", distinct people: " << nextId << std::endl;
+}
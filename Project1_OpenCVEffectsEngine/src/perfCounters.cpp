@@ -0,0 +1,139 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * perfCounters.cpp
+ * perf_event_open setup, reading with multiplex scaling, and the per-megapixel table.
+ */
+
+#include "perfCounters.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// glibc has no wrapper for this system call
+static int openCounter(unsigned int type, unsigned long long config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+static const char *counterNames[COUNTER_COUNT] = {"cycles", "instr", "L1D miss", "LLC miss", "br miss"};
+
+static double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+PerfCounters::PerfCounters() {
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        fds[c] = -1;
+    }
+#ifdef __linux__
+    fds[COUNTER_CYCLES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fds[COUNTER_INSTRUCTIONS] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds[COUNTER_L1D_MISSES] = openCounter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    // The generic cache-miss event is the last-level cache on x86 and most ARM cores
+    fds[COUNTER_LLC_MISSES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    fds[COUNTER_BRANCH_MISSES] = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        if (fds[c] >= 0) {
+            close(fds[c]);
+        }
+    }
+#endif
+}
+
+bool PerfCounters::available() const {
+    return fds[COUNTER_CYCLES] >= 0;
+}
+
+void PerfCounters::start() {
+#ifdef __linux__
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        if (fds[c] >= 0) {
+            ioctl(fds[c], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[c], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+    startTime = std::chrono::high_resolution_clock::now();
+}
+
+/*
+ * stop - Read every counter
+ * With more events than hardware counters the kernel time-slices them; the count is then
+ * extrapolated from the fraction of the interval the event was actually on the PMU.
+ */
+CounterReading PerfCounters::stop() {
+    CounterReading reading;
+    reading.ms = elapsedMs(startTime);
+#ifdef __linux__
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        if (fds[c] < 0) {
+            continue;
+        }
+        ioctl(fds[c], PERF_EVENT_IOC_DISABLE, 0);
+
+        unsigned long long data[3];   // value, time enabled, time running
+        if (read(fds[c], data, sizeof(data)) != (ssize_t)sizeof(data) || data[2] == 0) {
+            continue;
+        }
+        double scale = (double)data[1] / data[2];
+        reading.values[c] = (long long)(data[0] * scale);
+        reading.valid[c] = true;
+    }
+#endif
+    return reading;
+}
+
+void PerfCounters::printHeader() {
+    printf("Counters in events per pixel (millions per megapixel)\n");
+    printf("%-24s %9s", "stage", "ms/MP");
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        printf(" %10s", counterNames[c]);
+    }
+    printf(" %6s\n", "IPC");
+}
+
+void PerfCounters::printRow(const std::string &name, const CounterReading &reading, double megapixels, int runs) {
+    double perMp = (megapixels > 0 && runs > 0) ? 1.0 / (megapixels * runs) : 0.0;
+
+    printf("%-24s %9.3f", name.c_str(), reading.ms * perMp);
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        if (reading.valid[c]) {
+            // Millions per megapixel reads as events per pixel
+            printf(" %10.2f", reading.values[c] * perMp / 1e6);
+        } else {
+            printf(" %10s", "n/a");
+        }
+    }
+    if (reading.valid[COUNTER_CYCLES] && reading.valid[COUNTER_INSTRUCTIONS] && reading.values[COUNTER_CYCLES] > 0) {
+        printf(" %6.2f\n", (double)reading.values[COUNTER_INSTRUCTIONS] / reading.values[COUNTER_CYCLES]);
+    } else {
+        printf(" %6s\n", "n/a");
+    }
+}
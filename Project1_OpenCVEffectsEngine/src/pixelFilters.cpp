@@ -0,0 +1,211 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * pixelFilters.cpp
+ * Templated core filters and their explicit instantiations.
+ */
+
+#include "pixelFilters.h"
+#include <limits>
+
+namespace pixel {
+
+/*
+ * quantizeTable - 256-entry posterize table for a number of levels
+ * Rebuilt only when levels changes. thread_local so callers on different threads never see a
+ * table being rebuilt for other levels.
+ */
+const unsigned char *quantizeTable(int levels) {
+    thread_local unsigned char table[256];
+    thread_local int tableLevels = 0;
+
+    if (levels != tableLevels) {
+        int bucketSize = 255 / levels;
+        for (int v = 0; v < 256; v++) {
+            table[v] = (unsigned char)((v / bucketSize) * bucketSize);
+        }
+        tableLevels = levels;
+    }
+    return table;
+}
+
+/*
+ * greyscale - Custom grayscale conversion using inverted red channel
+ * For 8-bit BGR this is exactly the original greyscale(); other formats invert against their own range.
+ */
+template <typename T, int Channels>
+int greyscale(cv::Mat &src, cv::Mat &dst) {
+    const int maxValue = std::numeric_limits<T>::max();
+    dst.create(src.rows, src.cols, src.type());
+
+    for (int i = 0; i < src.rows; i++) {
+        const T *srcRow = src.ptr<T>(i);
+        T *dstRow = dst.ptr<T>(i);
+
+        for (int j = 0; j < src.cols; j++) {
+            const T *p = srcRow + j * Channels;
+            T *q = dstRow + j * Channels;
+
+            // Red is channel 2 for BGR/BGRA; gray has only one channel
+            T gray = (T)(maxValue - p[Channels >= 3 ? 2 : 0]);
+
+            for (int c = 0; c < (Channels == 4 ? 3 : Channels); c++) {
+                q[c] = gray;
+            }
+            if constexpr (Channels == 4) {
+                q[3] = p[3];
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * sepia - Sepia tone with the standard transformation matrix, clamped to the type's range
+ */
+template <typename T, int Channels>
+int sepia(cv::Mat &src, cv::Mat &dst) {
+    constexpr int outChannels = (Channels == 1) ? 3 : Channels;
+    const float maxValue = std::numeric_limits<T>::max();
+
+    // A 1-channel source cannot share memory with the 3-channel result
+    cv::Mat input = (Channels == 1 && dst.data == src.data) ? src.clone() : src;
+    dst.create(input.rows, input.cols, CV_MAKETYPE(cv::traits::Depth<T>::value, outChannels));
+
+    for (int i = 0; i < input.rows; i++) {
+        const T *srcRow = input.ptr<T>(i);
+        T *dstRow = dst.ptr<T>(i);
+
+        for (int j = 0; j < input.cols; j++) {
+            const T *p = srcRow + j * Channels;
+            T *q = dstRow + j * outChannels;
+
+            T blue = p[0];
+            T green = p[Channels >= 3 ? 1 : 0];
+            T red = p[Channels >= 3 ? 2 : 0];
+
+            float newBlue = 0.272 * red + 0.534 * green + 0.131 * blue;
+            float newGreen = 0.349 * red + 0.686 * green + 0.168 * blue;
+            float newRed = 0.393 * red + 0.769 * green + 0.189 * blue;
+
+            q[0] = (newBlue > maxValue) ? (T)maxValue : (T)newBlue;
+            q[1] = (newGreen > maxValue) ? (T)maxValue : (T)newGreen;
+            q[2] = (newRed > maxValue) ? (T)maxValue : (T)newRed;
+            if constexpr (Channels == 4) {
+                q[3] = p[3];
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * blur5x5_1 - Naive 5x5 Gaussian blur implementation
+ * Full 25-tap kernel per pixel, kept as the reference for the separable version.
+ */
+template <typename T, int Channels>
+int blur5x5_1(cv::Mat &src, cv::Mat &dst) {
+    static const int kernel[5][5] = {
+        {1, 2, 4, 2, 1},
+        {2, 4, 8, 4, 2},
+        {4, 8, 16, 8, 4},
+        {2, 4, 8, 4, 2},
+        {1, 2, 4, 2, 1}
+    };
+
+    // Every output pixel reads a 5x5 neighbourhood, so in place the source is kept in a
+    // per-thread scratch copy instead of cloning a fresh frame each call
+    thread_local cv::Mat scratch;
+    cv::Mat input = src;
+    if (dst.data == src.data) {
+        src.copyTo(scratch);
+        input = scratch;
+    } else {
+        src.copyTo(dst);
+    }
+
+    for (int i = 2; i < input.rows - 2; i++) {
+        T *dstRow = dst.ptr<T>(i);
+
+        for (int j = 2; j < input.cols - 2; j++) {
+            int sums[Channels] = {0};
+
+            for (int ki = -2; ki <= 2; ki++) {
+                const T *srcRow = input.ptr<T>(i + ki);
+                for (int kj = -2; kj <= 2; kj++) {
+                    const T *p = srcRow + (j + kj) * Channels;
+                    int weight = kernel[ki + 2][kj + 2];
+                    for (int c = 0; c < Channels; c++) {
+                        sums[c] += p[c] * weight;
+                    }
+                }
+            }
+
+            for (int c = 0; c < Channels; c++) {
+                dstRow[j * Channels + c] = (T)(sums[c] / 256);
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+ * quantize - Posterize each color channel into discrete levels
+ * Maps every value down to the start of its bucket of width maxValue / levels. 8-bit data goes
+ * through a 256-entry table; 16-bit data computes the bucket directly. Alpha is copied unchanged,
+ * as in greyscale and sepia.
+ */
+template <typename T, int Channels>
+int quantize(cv::Mat &src, cv::Mat &dst, int levels) {
+    const int maxValue = std::numeric_limits<T>::max();
+    if (levels < 1 || levels > maxValue) {
+        return -1;
+    }
+
+    int bucketSize = maxValue / levels;
+    const unsigned char *table = (sizeof(T) == 1) ? quantizeTable(levels) : nullptr;
+
+    dst.create(src.rows, src.cols, src.type());
+
+    for (int i = 0; i < src.rows; i++) {
+        const T *srcRow = src.ptr<T>(i);
+        T *dstRow = dst.ptr<T>(i);
+
+        for (int j = 0; j < src.cols; j++) {
+            const T *p = srcRow + j * Channels;
+            T *q = dstRow + j * Channels;
+
+            for (int c = 0; c < (Channels == 4 ? 3 : Channels); c++) {
+                if constexpr (sizeof(T) == 1) {
+                    q[c] = table[p[c]];
+                } else {
+                    q[c] = (T)((p[c] / bucketSize) * bucketSize);
+                }
+            }
+            if constexpr (Channels == 4) {
+                q[3] = p[3];
+            }
+        }
+    }
+    return 0;
+}
+
+// Explicit instantiations for every format dispatchPixelFormat knows about
+#define INSTANTIATE_PIXEL_FILTERS(T, C)                              \
+    template int greyscale<T, C>(cv::Mat &, cv::Mat &);              \
+    template int sepia<T, C>(cv::Mat &, cv::Mat &);                  \
+    template int blur5x5_1<T, C>(cv::Mat &, cv::Mat &);              \
+    template int quantize<T, C>(cv::Mat &, cv::Mat &, int);
+
+INSTANTIATE_PIXEL_FILTERS(uchar, 1)
+INSTANTIATE_PIXEL_FILTERS(uchar, 3)
+INSTANTIATE_PIXEL_FILTERS(uchar, 4)
+INSTANTIATE_PIXEL_FILTERS(ushort, 1)
+INSTANTIATE_PIXEL_FILTERS(ushort, 3)
+
+#undef INSTANTIATE_PIXEL_FILTERS
+
+} // namespace pixel
@@ -0,0 +1,122 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * qualityController.cpp
+ * Level table and the hysteresis rules for stepping quality down and up.
+ */
+
+#include "qualityController.h"
+#include <algorithm>
+#include <iostream>
+
+// Weight of the newest frame in the smoothed frame time
+static const double smoothing = 0.15;
+
+// Over budget this many frames in a row before dropping a level
+static const int downDwell = 5;
+
+// Stepping up needs the average below this fraction of the budget; the next level costs more
+static const double headroom = 0.6;
+
+// Frames of headroom needed before stepping up, and its ceiling after repeated bounces
+static const int baseUpDwell = 45;
+static const int maxUpDwell = 720;
+
+// Frames after a change before the average is trusted again
+static const int settleFrames = 10;
+
+QualityController::QualityController(double budgetMs)
+    : budgetMs(budgetMs), enabled(false), current(0), smoothedMs(0), overFrames(0), underFrames(0),
+      sinceChange(0), upDwell(baseUpDwell), lastStepUp(false), frames(0), overBudget(0), stepsDown(0),
+      stepsUp(0), totalMs(0) {
+    // Cheapest knobs first: detection interval and blur passes are barely visible, scale and
+    // tile skipping are
+    levels = {
+        {1, 1, 0, false},
+        {1, 2, 1, false},
+        {2, 3, 1, false},
+        {2, 5, 1, true},
+        {4, 8, 1, true},
+    };
+    framesAtLevel.assign(levels.size(), 0);
+}
+
+void QualityController::setEnabled(bool on) {
+    enabled = on;
+    current = 0;
+    overFrames = 0;
+    underFrames = 0;
+    sinceChange = 0;
+    upDwell = baseUpDwell;
+    lastStepUp = false;
+}
+
+/*
+ * update - Smooth the frame time and move one level when the dwell rules say so
+ * A step up that is followed by a step down before the next up-dwell has passed counts as a
+ * bounce and doubles the up-dwell. Every full up-dwell a level then holds halves it again, down
+ * to the base, so a controller that bounced several times calms down over several quiet periods.
+ */
+void QualityController::update(double frameMs) {
+    frames++;
+    totalMs += frameMs;
+    if (frameMs > budgetMs) {
+        overBudget++;
+    }
+    framesAtLevel[level()]++;
+
+    smoothedMs = (frames == 1) ? frameMs : smoothedMs + smoothing * (frameMs - smoothedMs);
+    if (!enabled) {
+        return;
+    }
+
+    sinceChange++;
+    if (sinceChange < settleFrames) {
+        return;
+    }
+
+    overFrames = (smoothedMs > budgetMs) ? overFrames + 1 : 0;
+    underFrames = (smoothedMs < budgetMs * headroom) ? underFrames + 1 : 0;
+
+    if (overFrames >= downDwell && current < maxLevel()) {
+        if (lastStepUp && sinceChange < upDwell) {
+            upDwell = std::min(upDwell * 2, maxUpDwell);
+        }
+        current++;
+        stepsDown++;
+        lastStepUp = false;
+        sinceChange = 0;
+        overFrames = 0;
+        underFrames = 0;
+    } else if (underFrames >= upDwell && current > 0) {
+        current--;
+        stepsUp++;
+        lastStepUp = true;
+        sinceChange = 0;
+        overFrames = 0;
+        underFrames = 0;
+    } else if (sinceChange >= upDwell && upDwell > baseUpDwell) {
+        upDwell = std::max(baseUpDwell, upDwell / 2);
+        sinceChange = settleFrames;
+    }
+}
+
+void QualityController::printStats() const {
+    if (frames == 0) {
+        return;
+    }
+
+    std::cout << "Frame budget " << budgetMs << " ms: " << totalMs / frames << " ms/frame average, "
+              << overBudget << " of " << frames << " frames over budget" << std::endl;
+    if (stepsDown + stepsUp == 0 && framesAtLevel[0] == frames) {
+        return;
+    }
+    std::cout << "  Quality steps down: " << stepsDown << ", up: " << stepsUp << "; frames per level:";
+    for (size_t l = 0; l < framesAtLevel.size(); l++) {
+        std::cout << " L" << l << " " << 100.0 * framesAtLevel[l] / frames << "%";
+    }
+    std::cout << std::endl;
+}
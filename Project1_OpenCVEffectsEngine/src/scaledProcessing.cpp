@@ -0,0 +1,243 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * scaledProcessing.cpp
+ * Joint bilateral upsampling and reduced-resolution variants of the depth focus,
+ * cartoon and spotlight effects.
+ */
+
+#include "scaledProcessing.h"
+#include "filters.h"
+#include "depthEstimator.h"
+#include "guidedFilter.h"
+#include <chrono>
+#include <cmath>
+
+/*
+ * jointBilateralUpsample - Edge-aware upsampling guided by the full-resolution frame
+ * Each output pixel mixes its 2x2 low-res neighbours with bilinear weights scaled by how close
+ * their guide luma is to the output pixel's luma, so results do not bleed across edges.
+ */
+int jointBilateralUpsample(cv::Mat &lowRes, cv::Mat &guide, cv::Mat &dst, float sigmaRange) {
+    int channels = lowRes.channels();
+    if (lowRes.depth() != CV_8U || (channels != 1 && channels != 3) || guide.type() != CV_8UC3) {
+        return -1;
+    }
+
+    cv::Mat guideGray, guideLow;
+    cv::cvtColor(guide, guideGray, cv::COLOR_BGR2GRAY);
+    cv::resize(guideGray, guideLow, lowRes.size(), 0, 0, cv::INTER_AREA);
+
+    // Range weights indexed by absolute luma difference
+    float rangeLut[256];
+    for (int d = 0; d < 256; d++) {
+        rangeLut[d] = std::exp(-(d * d) / (2.0f * sigmaRange * sigmaRange));
+    }
+
+    float scaleX = (float)lowRes.cols / guide.cols;
+    float scaleY = (float)lowRes.rows / guide.rows;
+
+    // Horizontal neighbours and weights are the same for every row
+    std::vector<int> x0s(guide.cols), x1s(guide.cols);
+    std::vector<float> wxs(guide.cols);
+    for (int j = 0; j < guide.cols; j++) {
+        float fx = (j + 0.5f) * scaleX - 0.5f;
+        int x0 = (int)std::floor(fx);
+        float wx = fx - x0;
+        x0s[j] = std::min(std::max(x0, 0), lowRes.cols - 1);
+        x1s[j] = std::min(std::max(x0 + 1, 0), lowRes.cols - 1);
+        wxs[j] = wx;
+    }
+
+    dst.create(guide.rows, guide.cols, lowRes.type());
+
+    for (int i = 0; i < guide.rows; i++) {
+        float fy = (i + 0.5f) * scaleY - 0.5f;
+        int y0 = (int)std::floor(fy);
+        float wy = fy - y0;
+        int y1 = std::min(std::max(y0 + 1, 0), lowRes.rows - 1);
+        y0 = std::min(std::max(y0, 0), lowRes.rows - 1);
+
+        unsigned char *gRow = guideGray.ptr<unsigned char>(i);
+        unsigned char *gLow0 = guideLow.ptr<unsigned char>(y0);
+        unsigned char *gLow1 = guideLow.ptr<unsigned char>(y1);
+        unsigned char *low0 = lowRes.ptr<unsigned char>(y0);
+        unsigned char *low1 = lowRes.ptr<unsigned char>(y1);
+        unsigned char *dstRow = dst.ptr<unsigned char>(i);
+
+        for (int j = 0; j < guide.cols; j++) {
+            int x0 = x0s[j];
+            int x1 = x1s[j];
+            float wx = wxs[j];
+            int g = gRow[j];
+
+            float w00 = (1 - wx) * (1 - wy) * rangeLut[std::abs(g - gLow0[x0])];
+            float w01 = wx * (1 - wy) * rangeLut[std::abs(g - gLow0[x1])];
+            float w10 = (1 - wx) * wy * rangeLut[std::abs(g - gLow1[x0])];
+            float w11 = wx * wy * rangeLut[std::abs(g - gLow1[x1])];
+            float total = w00 + w01 + w10 + w11;
+
+            // No neighbour resembles this pixel: fall back to plain bilinear
+            if (total < 1e-4f) {
+                w00 = (1 - wx) * (1 - wy);
+                w01 = wx * (1 - wy);
+                w10 = (1 - wx) * wy;
+                w11 = wx * wy;
+                total = 1.0f;
+            }
+            float inv = 1.0f / total;
+
+            for (int c = 0; c < channels; c++) {
+                float v = w00 * low0[x0 * channels + c] + w01 * low0[x1 * channels + c] +
+                          w10 * low1[x0 * channels + c] + w11 * low1[x1 * channels + c];
+                dstRow[j * channels + c] = cv::saturate_cast<unsigned char>(v * inv);
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * depthFocusScaled - Portrait mode with the heavy stages at reduced resolution
+ * Estimates depth and blurs at 1/scale, upsamples depth edge-aware and the blur bilinearly,
+ * then blends at full resolution so the in-focus subject keeps full detail.
+ * blurPasses overrides the number of background blur passes (default 2 at full size, 1 scaled).
+ * guided replaces the depth path with the guided filter, which always works at 1/4 or smaller.
+ */
+int depthFocusScaled(cv::Mat &src, cv::Mat &dst, int scale, int blurPasses, bool guided) {
+    if (scale <= 1) {
+        cv::Mat depth;
+        if (guided) {
+            guidedDepth(src, depth);
+        } else {
+            estimateDepth(src, depth);
+        }
+        if (blurPasses <= 0) {
+            return depthFocusEffect(src, depth, dst);
+        }
+
+        cv::Mat blurred;
+        blur5x5_2(src, blurred);
+        for (int pass = 1; pass < blurPasses; pass++) {
+            blur5x5_2(blurred, blurred);
+        }
+        return depthBlend(src, blurred, depth, dst);
+    }
+
+    cv::Mat small;
+    cv::resize(src, small, cv::Size(src.cols / scale, src.rows / scale), 0, 0, cv::INTER_AREA);
+
+    // Shrink the smoothing window with the image so the depth map looks the same
+    cv::Mat depthSmall, depth;
+    if (guided) {
+        guidedDepth(src, depth, std::max(scale, 4));
+    } else {
+        estimateDepth(small, depthSmall, (31 / scale) | 1);
+        jointBilateralUpsample(depthSmall, src, depth);
+    }
+
+    // Downsampling already removes most detail, one blur pass matches two at full size
+    cv::Mat blurredSmall, blurred;
+    blur5x5_2(small, blurredSmall);
+    for (int pass = 1; pass < blurPasses; pass++) {
+        blur5x5_2(blurredSmall, blurredSmall);
+    }
+    cv::resize(blurredSmall, blurred, src.size(), 0, 0, cv::INTER_LINEAR);
+
+    return depthBlend(src, blurred, depth, dst);
+}
+
+/*
+ * blurQuantizeScaled - Cartoon effect with the blur at reduced resolution
+ * The blurred colors are upsampled edge-aware before quantization so region boundaries stay on
+ * image edges; outlines are still detected on the full-resolution frame.
+ */
+int blurQuantizeScaled(cv::Mat &src, cv::Mat &dst, int levels, int scale) {
+    if (scale <= 1) {
+        return blurQuantize(src, dst, levels);
+    }
+
+    cv::Mat small, blurredSmall, blurred;
+    cv::resize(src, small, cv::Size(src.cols / scale, src.rows / scale), 0, 0, cv::INTER_AREA);
+    blur5x5_2(small, blurredSmall);
+    jointBilateralUpsample(blurredSmall, src, blurred);
+
+    cv::Mat quantized;
+    quantize(blurred, quantized, levels);
+
+    return darkenEdges(quantized, src, dst);
+}
+
+/*
+ * spotlightFaceScaled - Spotlight with the radial mask built at reduced resolution
+ * The falloff is smooth, so a bilinear upsample of the small mask is visually identical.
+ */
+int spotlightFaceScaled(cv::Mat &src, std::vector<cv::Rect> &faces, cv::Mat &dst, int scale) {
+    if (scale <= 1 || faces.empty()) {
+        return spotlightFace(src, faces, dst);
+    }
+
+    std::vector<cv::Rect> smallFaces;
+    for (size_t f = 0; f < faces.size(); f++) {
+        smallFaces.push_back(cv::Rect(faces[f].x / scale, faces[f].y / scale,
+                                      faces[f].width / scale, faces[f].height / scale));
+    }
+
+    cv::Mat maskSmall, mask;
+    spotlightMask(cv::Size(src.cols / scale, src.rows / scale), smallFaces, 80 / scale, maskSmall);
+    cv::resize(maskSmall, mask, src.size(), 0, 0, cv::INTER_LINEAR);
+
+    return applySpotlight(src, mask, dst);
+}
+
+/*
+ * testScaleQuality - Quality and speed report for reduced-resolution processing
+ * Times each effect 20 times at full, 1/2 and 1/4 resolution and reports PSNR against full resolution.
+ */
+void testScaleQuality(cv::Mat &testImage) {
+    const int runs = 20;
+
+    // Fixed face in the middle third so the spotlight has something to light
+    std::vector<cv::Rect> faces;
+    faces.push_back(cv::Rect(testImage.cols / 3, testImage.rows / 3, testImage.cols / 3, testImage.rows / 3));
+
+    const char *names[3] = {"depth focus", "cartoon", "spotlight"};
+
+    std::cout << "\n=== Reduced-Resolution Processing ===" << std::endl;
+    std::cout << "Image size: " << testImage.cols << "x" << testImage.rows << std::endl;
+
+    for (int effect = 0; effect < 3; effect++) {
+        cv::Mat reference;
+        double fullTime = 0.0;
+
+        int scales[3] = {1, 2, 4};
+        for (int s = 0; s < 3; s++) {
+            int scale = scales[s];
+            cv::Mat out;
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < runs; i++) {
+                if (effect == 0) depthFocusScaled(testImage, out, scale);
+                else if (effect == 1) blurQuantizeScaled(testImage, out, 10, scale);
+                else spotlightFaceScaled(testImage, faces, out, scale);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double avgTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / (double)runs / 1000.0;
+
+            if (scale == 1) {
+                reference = out;
+                fullTime = avgTime;
+                std::cout << names[effect] << " full: " << avgTime << " ms" << std::endl;
+            } else {
+                std::cout << names[effect] << " 1/" << scale << ": " << avgTime << " ms"
+                          << ", speedup " << fullTime / avgTime << "x"
+                          << ", PSNR " << cv::PSNR(reference, out) << " dB" << std::endl;
+            }
+        }
+    }
+    std::cout << "=====================================\n" << std::endl;
+}
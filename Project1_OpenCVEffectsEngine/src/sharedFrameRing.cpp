@@ -0,0 +1,333 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * sharedFrameRing.cpp
+ * POSIX shared-memory segment setup and the seqlock publish/read protocol.
+ */
+
+#include "sharedFrameRing.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// Readers in other processes only see consistent counters if these never fall back to a lock
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "frame ring needs lock-free 64-bit atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "frame ring needs lock-free 32-bit atomics");
+
+// shm_open wants a leading slash
+static std::string segmentPath(const std::string &name) {
+    return (!name.empty() && name[0] == '/') ? name : "/" + name;
+}
+
+static size_t roundUp(size_t bytes, size_t alignment) {
+    return (bytes + alignment - 1) / alignment * alignment;
+}
+
+SharedFrameRing::SharedFrameRing()
+    : owner(false), base(nullptr), mappedBytes(0), header(nullptr), nextFrame(0),
+      published(0), oversized(0), delivered(0), skipped(0), torn(0) {}
+
+SharedFrameRing::~SharedFrameRing() {
+    close();
+}
+
+/*
+ * create - Make a fresh segment and lay out the header and empty slots
+ * An old segment of the same name is unlinked first; readers still mapping it keep their copy.
+ */
+bool SharedFrameRing::create(const std::string &name, int slots, size_t slotCapacity) {
+#ifdef __linux__
+    close();
+    if (slots < 2 || slotCapacity == 0) {
+        std::cout << "Error: a frame ring needs at least 2 slots" << std::endl;
+        return false;
+    }
+
+    segmentName = segmentPath(name);
+    shm_unlink(segmentName.c_str());
+    int fd = shm_open(segmentName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cout << "Error creating shared memory " << segmentName << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    size_t headerBytes = roundUp(sizeof(RingHeader), 64);
+    size_t stride = roundUp(sizeof(SlotHeader) + slotCapacity, 4096);
+    size_t total = headerBytes + stride * slots;
+    if (ftruncate(fd, (off_t)total) != 0) {
+        std::cout << "Error sizing shared memory: " << strerror(errno) << std::endl;
+        ::close(fd);
+        shm_unlink(segmentName.c_str());
+        return false;
+    }
+
+    void *mapped = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        std::cout << "Error: mmap failed: " << strerror(errno) << std::endl;
+        shm_unlink(segmentName.c_str());
+        return false;
+    }
+
+    // ftruncate zero-fills, so every slot starts at sequence 0 (never written)
+    base = (unsigned char *)mapped;
+    mappedBytes = total;
+    owner = true;
+    header = new (base) RingHeader();
+    header->version = frameRingVersion;
+    header->slotCount = (uint32_t)slots;
+    header->headerBytes = (uint32_t)headerBytes;
+    header->slotStride = stride;
+    header->slotCapacity = slotCapacity;
+    header->writeCount.store(0, std::memory_order_relaxed);
+    for (int s = 0; s < slots; s++) {
+        new (base + headerBytes + stride * s) SlotHeader();
+    }
+
+    // Magic last, so a reader that opens mid-setup rejects the segment instead of misreading it
+    header->magic.store(frameRingMagic, std::memory_order_release);
+    return true;
+#else
+    (void)name; (void)slots; (void)slotCapacity;
+    std::cout << "Error: the shared-memory frame ring is only available on Linux" << std::endl;
+    return false;
+#endif
+}
+
+bool SharedFrameRing::open(const std::string &name) {
+#ifdef __linux__
+    close();
+
+    segmentName = segmentPath(name);
+    int fd = shm_open(segmentName.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        std::cout << "Error opening shared memory " << segmentName << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(RingHeader)) {
+        std::cout << "Error: " << segmentName << " is not a frame ring" << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void *mapped = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        std::cout << "Error: mmap failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+    base = (unsigned char *)mapped;
+    mappedBytes = (size_t)info.st_size;
+
+    // Acquire on magic makes the creator's header fields visible before they are checked
+    const RingHeader *ring = (const RingHeader *)base;
+    if (ring->magic.load(std::memory_order_acquire) != frameRingMagic || ring->version != frameRingVersion ||
+        ring->headerBytes + ring->slotStride * ring->slotCount > mappedBytes ||
+        ring->slotStride < sizeof(SlotHeader) + ring->slotCapacity) {
+        std::cout << "Error: " << segmentName << " is not a version " << frameRingVersion << " frame ring" << std::endl;
+        munmap(base, mappedBytes);
+        base = nullptr;
+        mappedBytes = 0;
+        return false;
+    }
+
+    // The mapping is read-only; the cast only lets the reader share the accessors with the writer
+    header = (RingHeader *)base;
+    owner = false;
+
+    // Start with live frames rather than whatever history is still in the ring
+    nextFrame = header->writeCount.load(std::memory_order_acquire);
+    return true;
+#else
+    (void)name;
+    std::cout << "Error: the shared-memory frame ring is only available on Linux" << std::endl;
+    return false;
+#endif
+}
+
+SlotHeader *SharedFrameRing::slotAt(uint64_t frameNumber) const {
+    return (SlotHeader *)(base + header->headerBytes + header->slotStride * (frameNumber % header->slotCount));
+}
+
+/*
+ * publish - Write the frame into the next slot under its seqlock
+ * The sequence goes odd before the first byte changes and even again after the last, so a
+ * reader overlapping the copy always sees a mismatch. Readers are never waited for.
+ */
+int SharedFrameRing::publish(const cv::Mat &frame) {
+    if (!header || !owner || frame.empty()) {
+        return -1;
+    }
+
+    size_t rowBytes = frame.cols * frame.elemSize();
+    size_t size = rowBytes * frame.rows;
+    if (size > header->slotCapacity) {
+        oversized++;
+        return -1;
+    }
+
+    uint64_t n = header->writeCount.load(std::memory_order_relaxed);
+    SlotHeader *slot = slotAt(n);
+
+    slot->sequence.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->frameNumber = n;
+    slot->timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    slot->rows = frame.rows;
+    slot->cols = frame.cols;
+    slot->type = frame.type();
+    slot->step = (uint32_t)rowBytes;
+    slot->size = size;
+
+    unsigned char *payload = (unsigned char *)(slot + 1);
+    if (frame.isContinuous()) {
+        memcpy(payload, frame.data, size);
+    } else {
+        for (int y = 0; y < frame.rows; y++) {
+            memcpy(payload + y * rowBytes, frame.ptr(y), rowBytes);
+        }
+    }
+
+    slot->sequence.store(2 * n + 2, std::memory_order_release);
+    header->writeCount.store(n + 1, std::memory_order_release);
+    published++;
+    return 0;
+}
+
+/*
+ * viewSlot - Wrap frame frameNumber in place if it is complete and still in its slot
+ * The header fields are copied and re-validated against the sequence before they are trusted.
+ */
+bool SharedFrameRing::viewSlot(uint64_t frameNumber, RingFrame &frame) {
+    const SlotHeader *slot = slotAt(frameNumber);
+    uint64_t before = slot->sequence.load(std::memory_order_acquire);
+    if (before != 2 * frameNumber + 2) {
+        return false;
+    }
+
+    int rows = slot->rows;
+    int cols = slot->cols;
+    int type = slot->type;
+    size_t step = slot->step;
+    size_t size = slot->size;
+    int64_t timestamp = slot->timestampNs;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->sequence.load(std::memory_order_relaxed) != before) {
+        return false;
+    }
+    if (rows <= 0 || cols <= 0 || size > header->slotCapacity || step * rows != size) {
+        return false;
+    }
+
+    frame.image = cv::Mat(rows, cols, type, (void *)(slot + 1), step);
+    frame.frameNumber = frameNumber;
+    frame.timestampNs = timestamp;
+    frame.sequence = before;
+    frame.slot = slot;
+    return true;
+}
+
+bool SharedFrameRing::latest(RingFrame &frame) {
+    if (!header) {
+        return false;
+    }
+
+    uint64_t written = header->writeCount.load(std::memory_order_acquire);
+    // The newest frame's slot is only rewritten slotCount frames later, so one retry is plenty
+    for (uint64_t back = 1; back <= 2 && back <= written; back++) {
+        if (viewSlot(written - back, frame)) {
+            delivered++;
+            nextFrame = frame.frameNumber + 1;
+            return true;
+        }
+        torn++;
+    }
+    return false;
+}
+
+/*
+ * next - Deliver frames in order, skipping whatever the writer has already overwritten
+ * The slot of frame written - slotCount may be mid-rewrite, so a reader that far behind
+ * resumes at the oldest frame that is still safe.
+ */
+bool SharedFrameRing::next(RingFrame &frame) {
+    if (!header) {
+        return false;
+    }
+
+    uint64_t written = header->writeCount.load(std::memory_order_acquire);
+    while (nextFrame < written) {
+        uint64_t oldest = written - std::min<uint64_t>(written, header->slotCount - 1);
+        if (nextFrame < oldest) {
+            skipped += oldest - nextFrame;
+            nextFrame = oldest;
+        }
+
+        if (viewSlot(nextFrame, frame)) {
+            delivered++;
+            nextFrame++;
+            return true;
+        }
+
+        // Overwritten while we looked; move on and try the following frame
+        torn++;
+        nextFrame++;
+        written = header->writeCount.load(std::memory_order_acquire);
+    }
+    return false;
+}
+
+bool SharedFrameRing::stillValid(const RingFrame &frame) const {
+    if (!frame.slot) {
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return frame.slot->sequence.load(std::memory_order_relaxed) == frame.sequence;
+}
+
+void SharedFrameRing::close() {
+#ifdef __linux__
+    if (base) {
+        munmap(base, mappedBytes);
+        if (owner) {
+            shm_unlink(segmentName.c_str());
+        }
+    }
+#endif
+    base = nullptr;
+    header = nullptr;
+    mappedBytes = 0;
+    owner = false;
+}
+
+void SharedFrameRing::printStats() const {
+    if (published > 0 || oversized > 0) {
+        std::cout << "Frame ring " << segmentName << ": " << published << " frames published";
+        if (oversized > 0) {
+            std::cout << ", " << oversized << " too large for a slot";
+        }
+        std::cout << std::endl;
+    }
+    if (delivered > 0 || skipped > 0) {
+        std::cout << "Frame ring " << segmentName << ": " << delivered << " frames read, "
+                  << skipped << " skipped (fell behind), " << torn << " overwritten while reading" << std::endl;
+    }
+}
@@ -0,0 +1,433 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * streamHost.cpp
+ * Runs an effect chain on many video sources at once. Every source has its own
+ * capture thread and effect chain; all per-frame work is split into bands of
+ * equal pixel count and scheduled on one shared work-stealing pool.
+ * Usage: streamHost [--headless] [--seconds N] source[@effect+effect...] ...
+ *   source: camera index, video file or recording; effects: grey, sepia, blur,
+ *   cartoon, sketch, colorpop (default: none).
+ */
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "filtersV2.h"
+#include "workStealingPool.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// Pixels per band task; small enough that no stream holds the pool for long
+static const int bandPixels = 64 * 1024;
+
+static double msBetween(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 1000.0;
+}
+
+// One stage of a stream's effect chain
+struct Effect {
+    std::string name;
+    int halo;     // rows/columns past a band the effect reads
+    std::function<int(const cv::Mat &, cv::Mat &)> apply;
+};
+
+/*
+ * makeEffect - Look up an effect by name; false for unknown names
+ */
+static bool makeEffect(const std::string &name, Effect &effect) {
+    effect.name = name;
+    if (name == "grey") {
+        effect.halo = 0;
+        effect.apply = [](const cv::Mat &src, cv::Mat &dst) { return v2::greyscale(src, dst); };
+    } else if (name == "sepia") {
+        effect.halo = 0;
+        effect.apply = [](const cv::Mat &src, cv::Mat &dst) { return v2::sepia(src, dst); };
+    } else if (name == "blur") {
+        effect.halo = 2;
+        effect.apply = [](const cv::Mat &src, cv::Mat &dst) { return v2::blur5x5(src, dst); };
+    } else if (name == "cartoon") {
+        effect.halo = 2;
+        effect.apply = [](const cv::Mat &src, cv::Mat &dst) { return v2::blurQuantize(src, dst, 10); };
+    } else if (name == "sketch") {
+        effect.halo = 1;
+        effect.apply = [](const cv::Mat &src, cv::Mat &dst) { return v2::sketch(src, dst); };
+    } else if (name == "colorpop") {
+        effect.halo = 0;
+        effect.apply = [](const cv::Mat &src, cv::Mat &dst) { return v2::colorPop(src, dst, 2); };
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/*
+ * runBand - Apply one effect to the rows of band, reading halo rows around it
+ * Bands of the same frame run concurrently, so each one writes only its own rows of dst.
+ */
+static int runBand(const Effect &effect, const cv::Mat &src, cv::Mat &dst, cv::Rect band) {
+    if (effect.halo == 0) {
+        cv::Mat out = dst(band);
+        return effect.apply(src(band), out);
+    }
+
+    cv::Rect read = cv::Rect(band.x, band.y - effect.halo, band.width, band.height + 2 * effect.halo) &
+                    cv::Rect(0, 0, src.cols, src.rows);
+
+    thread_local cv::Mat scratch;
+    if (effect.apply(src(read), scratch) != 0) {
+        return -1;
+    }
+    scratch(cv::Rect(0, band.y - read.y, band.width, band.height)).copyTo(dst(band));
+    return 0;
+}
+
+// One source with its capture thread, effect chain and statistics
+struct Stream {
+    int index;
+    std::string source;
+    std::vector<Effect> effects;
+    std::unique_ptr<cv::VideoCapture> capture;
+    std::thread grabber;
+
+    // Latest captured frame; the grabber overwrites it if the host has not taken it yet
+    std::mutex mailboxLock;
+    cv::Mat mailbox;
+    Clock::time_point mailboxTime;
+    bool mailboxFull = false;
+    std::atomic<bool> finished{false};
+
+    // Frame in flight, owned by the host thread between admit and completion
+    bool busy = false;
+    cv::Mat buffers[2];
+    int current = 0;
+    size_t stage = 0;
+    Clock::time_point captured;
+    std::vector<cv::Rect> bands;
+    size_t nextBand = 0;
+    std::atomic<int> bandsLeft{0};
+
+    // Shown by the host thread
+    cv::Mat output;
+    bool outputReady = false;
+
+    long long framesCaptured = 0;
+    long long framesDropped = 0;
+    long long framesDone = 0;
+    long long tasksRun = 0;
+    double latencyTotal = 0;
+    double latencyMax = 0;
+    Clock::time_point firstDone;
+    Clock::time_point lastDone;
+};
+
+/*
+ * grabLoop - Capture frames into the stream's mailbox until the source ends or the host stops
+ * Files are paced at their own frame rate so they behave like a live source.
+ */
+static void grabLoop(Stream &stream, std::atomic<bool> &stopping, std::condition_variable &wake, std::mutex &wakeLock,
+                     bool isFile) {
+    double fps = isFile ? stream.capture->get(cv::CAP_PROP_FPS) : 0;
+    auto period = std::chrono::microseconds(fps > 0 ? (long long)(1e6 / fps) : 0);
+    Clock::time_point next = Clock::now();
+
+    cv::Mat frame;
+    while (!stopping) {
+        if (!stream.capture->read(frame) || frame.empty()) {
+            break;
+        }
+        if (frame.type() != CV_8UC3) {
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(stream.mailboxLock);
+            if (stream.mailboxFull) {
+                stream.framesDropped++;
+            }
+            // The host hands back its old buffer, so steady state swaps instead of allocating
+            cv::swap(stream.mailbox, frame);
+            stream.mailboxTime = Clock::now();
+            stream.mailboxFull = true;
+            stream.framesCaptured++;
+        }
+        {
+            std::lock_guard<std::mutex> guard(wakeLock);
+        }
+        wake.notify_one();
+
+        if (period.count() > 0) {
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    }
+
+    stream.finished = true;
+    {
+        std::lock_guard<std::mutex> guard(wakeLock);
+    }
+    wake.notify_one();
+}
+
+/*
+ * splitBands - Full-width row bands of about bandPixels pixels each
+ */
+static void splitBands(cv::Size size, std::vector<cv::Rect> &bands) {
+    bands.clear();
+    int rowsPerBand = std::max(1, bandPixels / std::max(size.width, 1));
+    for (int y = 0; y < size.height; y += rowsPerBand) {
+        bands.push_back(cv::Rect(0, y, size.width, std::min(rowsPerBand, size.height - y)));
+    }
+}
+
+/*
+ * parseStream - "source[@effect+effect...]" into a stream description
+ */
+static bool parseStream(const std::string &spec, Stream &stream) {
+    size_t at = spec.find('@');
+    stream.source = spec.substr(0, at);
+    if (at == std::string::npos) {
+        return true;
+    }
+
+    std::stringstream names(spec.substr(at + 1));
+    std::string name;
+    while (std::getline(names, name, '+')) {
+        Effect effect;
+        if (!makeEffect(name, effect)) {
+            std::cout << "ERROR: Unknown effect '" << name << "' in " << spec << std::endl;
+            return false;
+        }
+        stream.effects.push_back(effect);
+    }
+    return true;
+}
+
+static void printStats(std::vector<std::unique_ptr<Stream>> &streams, WorkStealingPool &pool) {
+    std::cout << "\n=== Stream statistics ===" << std::endl;
+    for (size_t s = 0; s < streams.size(); s++) {
+        Stream &stream = *streams[s];
+        double seconds = stream.framesDone > 1 ? msBetween(stream.firstDone, stream.lastDone) / 1000.0 : 0;
+        std::cout << "Stream " << stream.index << " (" << stream.source << "): " << stream.framesDone << " frames";
+        if (seconds > 0) {
+            std::cout << ", " << (stream.framesDone - 1) / seconds << " fps";
+        }
+        if (stream.framesDone > 0) {
+            std::cout << ", latency avg " << stream.latencyTotal / stream.framesDone << " ms, max "
+                      << stream.latencyMax << " ms";
+        }
+        std::cout << ", dropped " << stream.framesDropped << " / " << stream.framesCaptured
+                  << ", tasks " << stream.tasksRun << std::endl;
+    }
+    std::cout << "Pool: " << pool.size() << " workers, " << pool.tasksExecuted() << " tasks, "
+              << pool.tasksStolen() << " stolen" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    bool headless = false;
+    double runSeconds = 0;
+    std::vector<std::unique_ptr<Stream>> streams;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            runSeconds = atof(argv[++i]);
+        } else {
+            std::unique_ptr<Stream> stream(new Stream());
+            stream->index = (int)streams.size();
+            if (!parseStream(arg, *stream)) {
+                return -1;
+            }
+            streams.push_back(std::move(stream));
+        }
+    }
+
+    if (streams.empty()) {
+        std::cout << "Usage: " << argv[0] << " [--headless] [--seconds N] source[@effect+effect...] ..." << std::endl;
+        std::cout << "  effects: grey, sepia, blur, cartoon, sketch, colorpop" << std::endl;
+        return -1;
+    }
+
+    std::atomic<bool> stopping(false);
+    std::mutex wakeLock;
+    std::condition_variable wake;
+
+    // Open everything before starting any thread so a bad source fails fast
+    std::vector<bool> isFile(streams.size());
+    for (size_t s = 0; s < streams.size(); s++) {
+        Stream &stream = *streams[s];
+        bool isDevice = !stream.source.empty() && stream.source.find_first_not_of("0123456789") == std::string::npos;
+        isFile[s] = !isDevice;
+        stream.capture.reset(isDevice ? new cv::VideoCapture(atoi(stream.source.c_str()))
+                                      : new cv::VideoCapture(stream.source));
+        if (!stream.capture->isOpened()) {
+            std::cout << "ERROR: Unable to open " << stream.source << std::endl;
+            return -1;
+        }
+
+        std::string chain;
+        for (size_t e = 0; e < stream.effects.size(); e++) {
+            chain += (e ? "+" : "") + stream.effects[e].name;
+        }
+        std::cout << "Stream " << stream.index << ": " << stream.source << " -> " << (chain.empty() ? "none" : chain)
+                  << std::endl;
+    }
+
+    WorkStealingPool pool;
+    std::cout << "Scheduling on " << pool.size() << " workers" << std::endl;
+
+    for (size_t s = 0; s < streams.size(); s++) {
+        Stream &stream = *streams[s];
+        bool file = isFile[s];
+        stream.grabber = std::thread([&stream, &stopping, &wake, &wakeLock, file]() {
+            grabLoop(stream, stopping, wake, wakeLock, file);
+        });
+    }
+
+    // At most this many band tasks are queued at once; the rest wait in their stream's band list
+    const int maxOutstanding = 2 * pool.size();
+    std::atomic<int> outstanding(0);
+    size_t roundRobin = 0;
+    Clock::time_point start = Clock::now();
+
+    for (;;) {
+        bool anyActive = false;
+
+        for (size_t s = 0; s < streams.size(); s++) {
+            Stream &stream = *streams[s];
+            // Read before the mailbox so a source's final frame is always admitted
+            bool sourceDone = stream.finished;
+
+            // Finished stage: move to the next effect or complete the frame
+            if (stream.busy && stream.nextBand == stream.bands.size() && stream.bandsLeft == 0) {
+                if (stream.stage < stream.effects.size()) {
+                    stream.current ^= 1;
+                }
+                stream.stage++;
+                if (stream.stage < stream.effects.size()) {
+                    stream.nextBand = 0;
+                    stream.bandsLeft = (int)stream.bands.size();
+                } else {
+                    Clock::time_point now = Clock::now();
+                    double latency = msBetween(stream.captured, now);
+                    stream.latencyTotal += latency;
+                    stream.latencyMax = std::max(stream.latencyMax, latency);
+                    if (stream.framesDone == 0) {
+                        stream.firstDone = now;
+                    }
+                    stream.lastDone = now;
+                    stream.framesDone++;
+
+                    cv::swap(stream.output, stream.buffers[stream.current]);
+                    stream.outputReady = true;
+                    stream.busy = false;
+                }
+            }
+
+            // Admit the newest captured frame once the previous one is done
+            if (!stream.busy) {
+                std::lock_guard<std::mutex> guard(stream.mailboxLock);
+                if (stream.mailboxFull) {
+                    cv::swap(stream.buffers[0], stream.mailbox);
+                    stream.captured = stream.mailboxTime;
+                    stream.mailboxFull = false;
+
+                    stream.current = 0;
+                    stream.stage = 0;
+                    stream.buffers[1].create(stream.buffers[0].rows, stream.buffers[0].cols, CV_8UC3);
+                    splitBands(stream.buffers[0].size(), stream.bands);
+                    stream.nextBand = stream.effects.empty() ? stream.bands.size() : 0;
+                    stream.bandsLeft = stream.effects.empty() ? 0 : (int)stream.bands.size();
+                    stream.busy = true;
+                }
+            }
+
+            if (stream.busy || !sourceDone) {
+                anyActive = true;
+            }
+        }
+
+        // Fair share: hand out one band per stream per turn, so every stream gets the same
+        // rate of equal-sized tasks no matter how large its frames are
+        bool submitted = true;
+        while (outstanding < maxOutstanding && submitted) {
+            submitted = false;
+            for (size_t k = 0; k < streams.size() && outstanding < maxOutstanding; k++) {
+                Stream &stream = *streams[(roundRobin + k) % streams.size()];
+                if (!stream.busy || stream.nextBand >= stream.bands.size()) {
+                    continue;
+                }
+
+                Stream *target = &stream;
+                const Effect *effect = &stream.effects[stream.stage];
+                cv::Rect band = stream.bands[stream.nextBand++];
+                int from = stream.current;
+                outstanding++;
+                stream.tasksRun++;
+                pool.submit([target, effect, band, from, &outstanding, &wake, &wakeLock]() {
+                    runBand(*effect, target->buffers[from], target->buffers[from ^ 1], band);
+                    target->bandsLeft--;
+                    outstanding--;
+                    {
+                        std::lock_guard<std::mutex> guard(wakeLock);
+                    }
+                    wake.notify_one();
+                });
+                submitted = true;
+            }
+            roundRobin++;
+        }
+
+        if (!headless) {
+            for (size_t s = 0; s < streams.size(); s++) {
+                Stream &stream = *streams[s];
+                if (stream.outputReady) {
+                    cv::imshow("Stream " + std::to_string(stream.index) + ": " + stream.source, stream.output);
+                    stream.outputReady = false;
+                }
+            }
+            int key = cv::waitKey(1);
+            if ((key & 0xFF) == 'q' || (key & 0xFF) == 27) {
+                break;
+            }
+        }
+
+        if (!anyActive && outstanding == 0) {
+            break;
+        }
+        if (runSeconds > 0 && msBetween(start, Clock::now()) >= runSeconds * 1000.0) {
+            break;
+        }
+
+        // Sleep until a band finishes or a frame arrives
+        std::unique_lock<std::mutex> guard(wakeLock);
+        wake.wait_for(guard, std::chrono::milliseconds(headless ? 5 : 1));
+    }
+
+    stopping = true;
+    for (size_t s = 0; s < streams.size(); s++) {
+        streams[s]->grabber.join();
+    }
+    // Let queued bands finish before the streams they write to go away
+    while (outstanding > 0) {
+        std::this_thread::yield();
+    }
+
+    printStats(streams, pool);
+    cv::destroyAllWindows();
+    return 0;
+}
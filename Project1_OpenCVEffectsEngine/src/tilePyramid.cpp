@@ -0,0 +1,401 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * tilePyramid.cpp
+ * Cache file build and index loading, the LRU tile cache, and window rendering.
+ */
+
+#include "tilePyramid.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <sys/stat.h>
+
+static const char pyramidMagic[4] = {'T', 'P', 'Y', 'R'};
+static const int pyramidVersion = 1;
+
+// Tiles are stored lossy; at this quality the block edges are invisible even at 1:1
+static const int tileQuality = 90;
+
+template <typename T>
+static void writeValue(std::ofstream &out, T value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool readValue(std::ifstream &in, T &value) {
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return (bool)in;
+}
+
+// Level, tile row and tile column packed into one cache key
+static unsigned long long tileKey(int level, int tx, int ty) {
+    return ((unsigned long long)level << 48) | ((unsigned long long)ty << 24) | (unsigned long long)tx;
+}
+
+TilePyramid::TilePyramid(size_t maxTiles)
+    : tileSize(0), maxTiles(std::max<size_t>(maxTiles, 4)), residentBytes(0), tilesDecoded(0), cacheHits(0),
+      bytesRead(0), peakBytes(0) {
+}
+
+/*
+ * open - Use the cache when it matches the source, otherwise rebuild it
+ * The source's size and modification time are stored in the header, so an edited image is
+ * noticed without decoding it.
+ */
+int TilePyramid::open(const std::string &imagePath, const std::string &cachePath, int tileSize) {
+    if (tileSize < 16) {
+        return -1;
+    }
+
+    struct stat info;
+    if (stat(imagePath.c_str(), &info) != 0) {
+        std::cout << "ERROR: Could not read " << imagePath << std::endl;
+        return -1;
+    }
+    long long sourceBytes = (long long)info.st_size;
+    long long sourceTime = (long long)info.st_mtime;
+
+    if (loadIndex(cachePath, tileSize, sourceBytes, sourceTime) == 0) {
+        std::cout << "Tile cache: " << cachePath << std::endl;
+        return 0;
+    }
+
+    std::cout << "Building tile pyramid in " << cachePath << "..." << std::endl;
+    if (build(imagePath, cachePath, tileSize, sourceBytes, sourceTime) != 0) {
+        return -1;
+    }
+    return loadIndex(cachePath, tileSize, sourceBytes, sourceTime);
+}
+
+/*
+ * build - Decode the source once and write every level as compressed tiles
+ * OpenCV only decodes whole images, so this is the one step whose memory grows with the image:
+ * the full-size level plus the next one down. Each level is released as soon as the half-size
+ * level has been made from it, and the index is written last, once the offsets are known.
+ * Everything goes to <cache>.tmp with a zeroed source stamp; the stamp is patched in and the
+ * file renamed into place only after every tile and the index are on disk, so an interrupted
+ * build never leaves a cache that loadIndex would accept.
+ */
+int TilePyramid::build(const std::string &imagePath, const std::string &cachePath, int tileSize,
+                       long long sourceBytes, long long sourceTime) {
+    cv::Mat level = cv::imread(imagePath, cv::IMREAD_COLOR);
+    if (level.empty()) {
+        std::cout << "ERROR: Could not decode " << imagePath << std::endl;
+        return -1;
+    }
+
+    // Halve until a single tile holds the whole level
+    std::vector<cv::Size> sizes;
+    cv::Size size = level.size();
+    sizes.push_back(size);
+    while (size.width > tileSize || size.height > tileSize) {
+        size = cv::Size((size.width + 1) / 2, (size.height + 1) / 2);
+        sizes.push_back(size);
+    }
+
+    size_t tileCount = 0;
+    for (size_t l = 0; l < sizes.size(); l++) {
+        tileCount += (size_t)((sizes[l].width + tileSize - 1) / tileSize) * ((sizes[l].height + tileSize - 1) / tileSize);
+    }
+
+    std::string tempPath = cachePath + ".tmp";
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cout << "ERROR: Could not write " << tempPath << std::endl;
+        return -1;
+    }
+
+    out.write(pyramidMagic, sizeof(pyramidMagic));
+    writeValue<int>(out, pyramidVersion);
+    writeValue<int>(out, tileSize);
+    writeValue<int>(out, (int)sizes.size());
+    std::streampos stampPos = out.tellp();
+    writeValue<long long>(out, 0LL);
+    writeValue<long long>(out, 0LL);
+    for (size_t l = 0; l < sizes.size(); l++) {
+        writeValue<int>(out, sizes[l].width);
+        writeValue<int>(out, sizes[l].height);
+    }
+
+    // Index placeholder, filled in once every tile has been written
+    std::streampos indexPos = out.tellp();
+    std::vector<TileEntry> entries(tileCount);
+    for (size_t t = 0; t < tileCount; t++) {
+        writeValue<unsigned long long>(out, 0ULL);
+        writeValue<unsigned int>(out, 0U);
+    }
+
+    std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, tileQuality};
+    std::vector<unsigned char> encoded;
+    size_t entry = 0;
+    for (size_t l = 0; l < sizes.size(); l++) {
+        for (int y = 0; y < level.rows; y += tileSize) {
+            for (int x = 0; x < level.cols; x += tileSize) {
+                cv::Rect rect(x, y, std::min(tileSize, level.cols - x), std::min(tileSize, level.rows - y));
+                cv::imencode(".jpg", level(rect), encoded, params);
+                entries[entry].offset = (unsigned long long)out.tellp();
+                entries[entry].length = (unsigned int)encoded.size();
+                out.write(reinterpret_cast<const char *>(encoded.data()), encoded.size());
+                entry++;
+            }
+        }
+        std::cout << "  level " << l << ": " << level.cols << "x" << level.rows << std::endl;
+
+        if (l + 1 < sizes.size()) {
+            cv::Mat next;
+            cv::resize(level, next, sizes[l + 1], 0, 0, cv::INTER_AREA);
+            level = next;
+        }
+    }
+
+    out.seekp(indexPos);
+    for (size_t t = 0; t < tileCount; t++) {
+        writeValue<unsigned long long>(out, entries[t].offset);
+        writeValue<unsigned int>(out, entries[t].length);
+    }
+    out.flush();
+
+    // The source stamp is what makes the cache valid, so it goes in last
+    out.seekp(stampPos);
+    writeValue<long long>(out, sourceBytes);
+    writeValue<long long>(out, sourceTime);
+    out.close();
+
+    if (!out) {
+        std::cout << "ERROR: Writing " << tempPath << " failed" << std::endl;
+        std::remove(tempPath.c_str());
+        return -1;
+    }
+    // rename replaces the old cache atomically on POSIX; elsewhere it may refuse to overwrite
+    if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0 &&
+        (std::remove(cachePath.c_str()), std::rename(tempPath.c_str(), cachePath.c_str()) != 0)) {
+        std::cout << "ERROR: Could not move " << tempPath << " to " << cachePath << std::endl;
+        std::remove(tempPath.c_str());
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * loadIndex - Read the header and tile index, leaving the file open for tile reads
+ */
+int TilePyramid::loadIndex(const std::string &cachePath, int tileSize, long long sourceBytes, long long sourceTime) {
+    if (file.is_open()) {
+        file.close();
+    }
+    file.clear();
+    file.open(cachePath, std::ios::binary);
+    if (!file) {
+        return -1;
+    }
+
+    char magic[4];
+    int version, storedTileSize, levelCount;
+    long long storedBytes, storedTime;
+    file.read(magic, sizeof(magic));
+    if (!file || std::string(magic, 4) != std::string(pyramidMagic, 4) ||
+        !readValue(file, version) || version != pyramidVersion ||
+        !readValue(file, storedTileSize) || storedTileSize != tileSize ||
+        !readValue(file, levelCount) || levelCount < 1 || levelCount > 32 ||
+        !readValue(file, storedBytes) || storedBytes != sourceBytes ||
+        !readValue(file, storedTime) || storedTime != sourceTime) {
+        file.close();
+        return -1;
+    }
+
+    levels.clear();
+    size_t tileCount = 0;
+    for (int l = 0; l < levelCount; l++) {
+        Level level;
+        if (!readValue(file, level.width) || !readValue(file, level.height) || level.width < 1 || level.height < 1) {
+            file.close();
+            return -1;
+        }
+        level.tilesX = (level.width + tileSize - 1) / tileSize;
+        level.tilesY = (level.height + tileSize - 1) / tileSize;
+        level.firstTile = tileCount;
+        tileCount += (size_t)level.tilesX * level.tilesY;
+        levels.push_back(level);
+    }
+
+    // Tile data follows the index; every entry must be non-empty and lie inside the file
+    index.resize(tileCount);
+    for (size_t t = 0; t < tileCount; t++) {
+        if (!readValue(file, index[t].offset) || !readValue(file, index[t].length)) {
+            file.close();
+            return -1;
+        }
+    }
+    unsigned long long dataStart = (unsigned long long)file.tellg();
+    file.seekg(0, std::ios::end);
+    unsigned long long fileBytes = (unsigned long long)file.tellg();
+    for (size_t t = 0; t < tileCount; t++) {
+        if (index[t].length == 0 || index[t].offset < dataStart ||
+            index[t].offset + index[t].length > fileBytes) {
+            file.close();
+            return -1;
+        }
+    }
+
+    this->tileSize = tileSize;
+    lru.clear();
+    lookup.clear();
+    residentBytes = 0;
+    return 0;
+}
+
+/*
+ * tile - Decoded tile from the LRU cache, reading and decoding it on a miss
+ * The least recently used tiles are dropped once the cache is full, which is what keeps memory
+ * bounded however far the view wanders.
+ */
+int TilePyramid::tile(int level, int tx, int ty, cv::Mat &dst) {
+    if (level < 0 || level >= (int)levels.size() || tx < 0 || ty < 0 ||
+        tx >= levels[level].tilesX || ty >= levels[level].tilesY) {
+        return -1;
+    }
+
+    unsigned long long key = tileKey(level, tx, ty);
+    auto found = lookup.find(key);
+    if (found != lookup.end()) {
+        lru.splice(lru.begin(), lru, found->second);
+        dst = found->second->second;
+        cacheHits++;
+        return 0;
+    }
+
+    const TileEntry &entry = index[levels[level].firstTile + (size_t)ty * levels[level].tilesX + tx];
+    std::vector<unsigned char> encoded(entry.length);
+    file.clear();
+    file.seekg((std::streamoff)entry.offset);
+    file.read(reinterpret_cast<char *>(encoded.data()), entry.length);
+    if (!file) {
+        return -1;
+    }
+    bytesRead += entry.length;
+
+    cv::Mat decoded = cv::imdecode(encoded, cv::IMREAD_COLOR);
+    if (decoded.empty()) {
+        return -1;
+    }
+    tilesDecoded++;
+
+    while (lru.size() >= maxTiles) {
+        residentBytes -= lru.back().second.total() * lru.back().second.elemSize();
+        lookup.erase(lru.back().first);
+        lru.pop_back();
+    }
+    lru.push_front(CachedTile(key, decoded));
+    lookup[key] = lru.begin();
+    residentBytes += decoded.total() * decoded.elemSize();
+    peakBytes = std::max(peakBytes, residentBytes);
+
+    dst = decoded;
+    return 0;
+}
+
+int TilePyramid::region(int level, const cv::Rect &rect, cv::Mat &dst) {
+    if (level < 0 || level >= (int)levels.size() || rect.width <= 0 || rect.height <= 0) {
+        return -1;
+    }
+
+    dst.create(rect.height, rect.width, CV_8UC3);
+    int firstX = rect.x / tileSize;
+    int firstY = rect.y / tileSize;
+    int lastX = (rect.x + rect.width - 1) / tileSize;
+    int lastY = (rect.y + rect.height - 1) / tileSize;
+
+    for (int ty = firstY; ty <= lastY; ty++) {
+        for (int tx = firstX; tx <= lastX; tx++) {
+            cv::Mat t;
+            if (tile(level, tx, ty, t) != 0) {
+                return -1;
+            }
+            cv::Rect tileRect(tx * tileSize, ty * tileSize, t.cols, t.rows);
+            cv::Rect overlap = tileRect & rect;
+            if (overlap.width <= 0 || overlap.height <= 0) {
+                continue;
+            }
+            cv::Rect from(overlap.x - tileRect.x, overlap.y - tileRect.y, overlap.width, overlap.height);
+            cv::Rect to(overlap.x - rect.x, overlap.y - rect.y, overlap.width, overlap.height);
+            t(from).copyTo(dst(to));
+        }
+    }
+    return 0;
+}
+
+/*
+ * render - Draw the window from the level that matches the zoom
+ * The visible part of that level is at most about twice the window in each direction, so the
+ * tiles touched, the filter's work and the memory used all stay proportional to the window.
+ */
+int TilePyramid::render(double centerX, double centerY, double zoom, cv::Size viewport,
+                        const std::function<int(cv::Mat &, cv::Mat &)> &filter, int halo, cv::Mat &dst) {
+    dst.create(viewport.height, viewport.width, CV_8UC3);
+    dst.setTo(cv::Scalar(32, 32, 32));
+    if (levels.empty() || zoom <= 0.0) {
+        return -1;
+    }
+
+    // Coarsest level with at least one stored pixel per window pixel
+    int level = 0;
+    while (level + 1 < (int)levels.size() && zoom * (double)(1 << (level + 1)) <= 1.0) {
+        level++;
+    }
+    double scale = zoom * (double)(1 << level);
+
+    // Window bounds in the chosen level's pixels
+    double left = centerX / (1 << level) - viewport.width / (2.0 * scale);
+    double top = centerY / (1 << level) - viewport.height / (2.0 * scale);
+    double right = left + viewport.width / scale;
+    double bottom = top + viewport.height / scale;
+
+    cv::Rect bounds(0, 0, levels[level].width, levels[level].height);
+    cv::Rect visible = cv::Rect((int)std::floor(left), (int)std::floor(top),
+                                (int)std::ceil(right) - (int)std::floor(left),
+                                (int)std::ceil(bottom) - (int)std::floor(top)) & bounds;
+    if (visible.width <= 0 || visible.height <= 0) {
+        return level;
+    }
+
+    // Spatial filters read a few pixels past the visible edge so the window border is not an image border
+    cv::Rect padded = cv::Rect(visible.x - halo, visible.y - halo, visible.width + 2 * halo,
+                               visible.height + 2 * halo) & bounds;
+    cv::Mat pixels;
+    if (region(level, padded, pixels) != 0) {
+        return -1;
+    }
+    if (filter) {
+        cv::Mat filtered;
+        if (filter(pixels, filtered) == 0 && filtered.type() == CV_8UC3 && filtered.size() == pixels.size()) {
+            pixels = filtered;
+        }
+    }
+    cv::Mat shown = pixels(cv::Rect(visible.x - padded.x, visible.y - padded.y, visible.width, visible.height));
+
+    // Place the visible rectangle in the window; it may overhang the window by under a pixel
+    int screenX = (int)std::lround((visible.x - left) * scale);
+    int screenY = (int)std::lround((visible.y - top) * scale);
+    int screenW = std::max(1, (int)std::lround(visible.width * scale));
+    int screenH = std::max(1, (int)std::lround(visible.height * scale));
+
+    cv::Mat resized;
+    cv::resize(shown, resized, cv::Size(screenW, screenH), 0, 0, scale < 1.0 ? cv::INTER_AREA : cv::INTER_NEAREST);
+
+    cv::Rect target = cv::Rect(screenX, screenY, screenW, screenH) & cv::Rect(0, 0, viewport.width, viewport.height);
+    if (target.width > 0 && target.height > 0) {
+        resized(cv::Rect(target.x - screenX, target.y - screenY, target.width, target.height)).copyTo(dst(target));
+    }
+    return level;
+}
+
+void TilePyramid::printStats() const {
+    std::cout << "Tile pyramid: " << levels.size() << " levels of " << tileSize << "px tiles, "
+              << tilesDecoded << " tiles decoded (" << bytesRead / 1024 << " KB read), " << cacheHits
+              << " cache hits, peak decoded " << peakBytes / (1024 * 1024.0) << " MB" << std::endl;
+}
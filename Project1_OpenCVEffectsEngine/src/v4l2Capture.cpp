@@ -0,0 +1,277 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * v4l2Capture.cpp
+ * V4L2 mmap streaming capture and helpers for reading YUYV/NV12 frames in place.
+ */
+
+#include "v4l2Capture.h"
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <linux/videodev2.h>
+
+// ioctl wrapper that retries when interrupted by a signal
+static int xioctl(int fd, unsigned long request, void *arg) {
+    int result;
+    do {
+        result = ioctl(fd, request, arg);
+    } while (result == -1 && errno == EINTR);
+    return result;
+}
+#endif
+
+V4L2Capture::V4L2Capture()
+    : fd(-1), frameWidth(0), frameHeight(0), bytesPerLine(0), pixelFormat(PIXFMT_YUYV) {}
+
+V4L2Capture::~V4L2Capture() {
+    close();
+}
+
+/*
+ * open - Open a V4L2 device and start mmap streaming
+ * Fails if the driver cannot deliver the requested pixel format, since the whole point is to
+ * avoid a conversion.
+ */
+bool V4L2Capture::open(const std::string &device, int width, int height, FramePixelFormat format, int bufferCount) {
+#ifdef __linux__
+    close();
+
+    fd = ::open(device.c_str(), O_RDWR);
+    if (fd < 0) {
+        std::cout << "Error opening " << device << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    v4l2_capability cap;
+    memset(&cap, 0, sizeof(cap));
+    if (xioctl(fd, VIDIOC_QUERYCAP, &cap) < 0) {
+        std::cout << "Error: " << device << " is not a V4L2 device" << std::endl;
+        close();
+        return false;
+    }
+
+    unsigned int caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS) ? cap.device_caps : cap.capabilities;
+    if (!(caps & V4L2_CAP_VIDEO_CAPTURE) || !(caps & V4L2_CAP_STREAMING)) {
+        std::cout << "Error: " << device << " does not support streaming capture" << std::endl;
+        close();
+        return false;
+    }
+
+    unsigned int fourcc = (format == PIXFMT_NV12) ? V4L2_PIX_FMT_NV12 : V4L2_PIX_FMT_YUYV;
+
+    v4l2_format fmt;
+    memset(&fmt, 0, sizeof(fmt));
+    fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    fmt.fmt.pix.width = width;
+    fmt.fmt.pix.height = height;
+    fmt.fmt.pix.pixelformat = fourcc;
+    fmt.fmt.pix.field = V4L2_FIELD_NONE;
+
+    if (xioctl(fd, VIDIOC_S_FMT, &fmt) < 0 || fmt.fmt.pix.pixelformat != fourcc) {
+        std::cout << "Error: " << device << " cannot capture "
+                  << (format == PIXFMT_NV12 ? "NV12" : "YUYV") << std::endl;
+        close();
+        return false;
+    }
+
+    frameWidth = fmt.fmt.pix.width;
+    frameHeight = fmt.fmt.pix.height;
+    bytesPerLine = fmt.fmt.pix.bytesperline;
+    pixelFormat = format;
+
+    v4l2_requestbuffers req;
+    memset(&req, 0, sizeof(req));
+    req.count = bufferCount;
+    req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory = V4L2_MEMORY_MMAP;
+
+    if (xioctl(fd, VIDIOC_REQBUFS, &req) < 0 || req.count < 2) {
+        std::cout << "Error: could not allocate capture buffers" << std::endl;
+        close();
+        return false;
+    }
+
+    for (unsigned int i = 0; i < req.count; i++) {
+        v4l2_buffer buf;
+        memset(&buf, 0, sizeof(buf));
+        buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        buf.index = i;
+
+        if (xioctl(fd, VIDIOC_QUERYBUF, &buf) < 0) {
+            close();
+            return false;
+        }
+
+        void *start = mmap(NULL, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, buf.m.offset);
+        if (start == MAP_FAILED) {
+            std::cout << "Error: mmap failed: " << strerror(errno) << std::endl;
+            close();
+            return false;
+        }
+        buffers.push_back({start, buf.length});
+
+        if (xioctl(fd, VIDIOC_QBUF, &buf) < 0) {
+            close();
+            return false;
+        }
+    }
+
+    v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (xioctl(fd, VIDIOC_STREAMON, &type) < 0) {
+        std::cout << "Error: could not start streaming" << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+#else
+    std::cout << "Error: V4L2 capture is only available on Linux" << std::endl;
+    return false;
+#endif
+}
+
+/*
+ * grab - Dequeue a filled buffer and wrap it as Mat views
+ * No pixel data is touched; the caller must release() the frame before the driver can reuse it.
+ */
+bool V4L2Capture::grab(V4L2Frame &frame) {
+#ifdef __linux__
+    if (fd < 0) {
+        return false;
+    }
+
+    v4l2_buffer buf;
+    memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+
+    if (xioctl(fd, VIDIOC_DQBUF, &buf) < 0) {
+        return false;
+    }
+
+    // An index past the mapped buffers would point the Mat outside every mapping; give it back
+    if (buf.index >= buffers.size()) {
+        std::cout << "Error: driver returned buffer " << buf.index << " of " << buffers.size() << std::endl;
+        xioctl(fd, VIDIOC_QBUF, &buf);
+        return false;
+    }
+
+    unsigned char *data = (unsigned char *)buffers[buf.index].start;
+
+    frame.format = pixelFormat;
+    frame.index = buf.index;
+    frame.sequence = buf.sequence;
+
+    if (pixelFormat == PIXFMT_NV12) {
+        frame.raw = cv::Mat(frameHeight * 3 / 2, frameWidth, CV_8UC1, data, bytesPerLine);
+        frame.luma = cv::Mat(frameHeight, frameWidth, CV_8UC1, data, bytesPerLine);
+    } else {
+        frame.raw = cv::Mat(frameHeight, frameWidth, CV_8UC2, data, bytesPerLine);
+        frame.luma.release();
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/*
+ * release - Requeue the frame's buffer
+ */
+void V4L2Capture::release(V4L2Frame &frame) {
+#ifdef __linux__
+    if (fd < 0 || frame.index < 0) {
+        return;
+    }
+
+    v4l2_buffer buf;
+    memset(&buf, 0, sizeof(buf));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = frame.index;
+    xioctl(fd, VIDIOC_QBUF, &buf);
+#endif
+    frame.raw.release();
+    frame.luma.release();
+    frame.index = -1;
+}
+
+/*
+ * close - Stop streaming and free driver buffers
+ */
+void V4L2Capture::close() {
+#ifdef __linux__
+    if (fd >= 0) {
+        v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        xioctl(fd, VIDIOC_STREAMOFF, &type);
+    }
+    for (size_t i = 0; i < buffers.size(); i++) {
+        munmap(buffers[i].start, buffers[i].length);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+    buffers.clear();
+    fd = -1;
+}
+
+/*
+ * frameToBGR - Single color conversion straight out of the driver buffer
+ */
+int frameToBGR(V4L2Frame &frame, cv::Mat &dst) {
+    if (frame.raw.empty()) {
+        return -1;
+    }
+    if (frame.format == PIXFMT_NV12) {
+        cv::cvtColor(frame.raw, dst, cv::COLOR_YUV2BGR_NV12);
+    } else {
+        cv::cvtColor(frame.raw, dst, cv::COLOR_YUV2BGR_YUYV);
+    }
+    return 0;
+}
+
+/*
+ * frameLumaView - Luma bytes without any copy
+ * For YUYV every other byte of each row is Y; for NV12 the Y plane is contiguous.
+ */
+int frameLumaView(V4L2Frame &frame, cv::Mat &plane, int &pixelStride) {
+    if (frame.raw.empty()) {
+        return -1;
+    }
+    if (frame.format == PIXFMT_NV12) {
+        plane = frame.luma;
+        pixelStride = 1;
+    } else {
+        plane = frame.raw;
+        pixelStride = 2;
+    }
+    return 0;
+}
+
+/*
+ * frameLuma - Contiguous luma image for neighbourhood filters and the face detector
+ */
+int frameLuma(V4L2Frame &frame, cv::Mat &gray) {
+    if (frame.raw.empty()) {
+        return -1;
+    }
+    if (frame.format == PIXFMT_NV12) {
+        gray = frame.luma;
+    } else {
+        cv::cvtColor(frame.raw, gray, cv::COLOR_YUV2GRAY_YUYV);
+    }
+    return 0;
+}
@@ -7,47 +7,351 @@
  * vidDisplay.cpp
  * Real-time video capture and display with interactive filter selection.
  * Main program that captures from webcam and applies effects based on keyboard input.
+ * Usage: vidDisplay [--v4l2 [device] [yuyv|nv12]] for zero-copy Linux capture,
+ *        vidDisplay --replay <video> to run the effects on recorded footage.
+ *        Either form takes --shm <name> to publish the shown frames to a shared-memory
+ *        ring that frameRingReader (or any other process) can map.
+ *        --headless runs without a window (Ctrl-C stops it), --keys <chars> presses keys
+ *        on the first frames, and --preview <port> [--preview-width W] [--preview-quality Q]
+ *        serves the shown frames as MJPEG on http://127.0.0.1:<port>/.
+ *        Grey, sepia and blur run whichever implementation the auto-tuner timed fastest;
+ *        --calibrate times them all on the first frame, --kernel <filter>=<variant> forces one.
+ *        --budget <ms> turns on the adaptive quality controller with that frame budget.
  */
 
 #include <opencv2/opencv.hpp>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
 #include <iostream>
+#include <thread>
 #include "filters.h"
 #include "depthEstimator.h"
+#include "scaledProcessing.h"
+#include "v4l2Capture.h"
+#include "frameRecorder.h"
+#include "dirtyTiles.h"
+#include "filtersV2.h"
+#include "effectsMosaic.h"
+#include "faceFeatures.h"
+#include "pedestrianDetector.h"
+#include "sharedFrameRing.h"
+#include "mjpegServer.h"
+#include "autoTuner.h"
+#include "qualityController.h"
+#include "bilateralGrid.h"
+#include "guidedFilter.h"
+
+// Process start, the reference point for the startup timing report
+static const std::chrono::steady_clock::time_point launchTime = std::chrono::steady_clock::now();
+
+static double msSinceLaunch()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - launchTime).count() / 1000.0;
+}
+
+// Set by Ctrl-C; the only way to stop a headless run on a live camera
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void requestStop(int)
+{
+    stopRequested = 1;
+}
+
+// When a face mode was last switched on, and whether its first detection is still to come
+static std::chrono::steady_clock::time_point detectModeStart;
+static bool firstDetectionPending = false;
+
+/*
+ * startFirstDetectionTimer - Called when a face mode is switched on
+ */
+static void startFirstDetectionTimer()
+{
+    detectModeStart = std::chrono::steady_clock::now();
+    firstDetectionPending = true;
+}
+
+/*
+ * reportFirstDetection - Print the time from switching the mode on to its first result
+ * Includes waiting for the next frame and any cascade loading the preload has not finished.
+ */
+static void reportFirstDetection(size_t faceCount)
+{
+    if (firstDetectionPending)
+    {
+        firstDetectionPending = false;
+        double ms = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - detectModeStart).count() / 1000.0;
+        std::cout << "Time to first detection: " << ms << " ms after the mode was switched on (" << faceCount << " faces)" << std::endl;
+    }
+}
+
+/*
+ * detectFacesInFrame - Run face detection on the cheapest available input
+ * With V4L2 capture the Y plane is used directly instead of converting BGR back to gray.
+ */
+static int detectFacesInFrame(bool useV4L2, V4L2Frame &v4l2Frame, cv::Mat &frame, std::vector<cv::Rect> &faces)
+{
+    int result;
+    if (useV4L2)
+    {
+        cv::Mat gray;
+        frameLuma(v4l2Frame, gray);
+        result = detectFacesGray(gray, faces);
+    }
+    else
+    {
+        result = detectFaces(frame, faces);
+    }
+
+    reportFirstDetection(faces.size());
+    return result;
+}
+
+/*
+ * detectFeaturesInFrame - Faces plus the eyes and smiles inside them
+ */
+static int detectFeaturesInFrame(bool useV4L2, V4L2Frame &v4l2Frame, cv::Mat &frame,
+                                 FaceFeatureDetector &detector, std::vector<FaceFeatures> &features)
+{
+    cv::Mat gray;
+    if (useV4L2)
+        frameLuma(v4l2Frame, gray);
+    else
+        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+
+    int result = detector.detect(gray, features);
+    reportFirstDetection(features.size());
+    return result;
+}
+
+/*
+ * sampledBrightness - Mean of every 4th byte on every 4th row
+ * Enough to follow auto-exposure during warm-up without reading the whole frame.
+ */
+static double sampledBrightness(const cv::Mat &plane, int pixelStride)
+{
+    long long sum = 0;
+    long long count = 0;
+    for (int i = 0; i < plane.rows; i += 4)
+    {
+        const unsigned char *row = plane.ptr<unsigned char>(i);
+        for (int j = 0; j < plane.cols; j += 4)
+        {
+            sum += row[j * pixelStride];
+            count++;
+        }
+    }
+    return count ? (double)sum / count : 0.0;
+}
+
+/*
+ * exposureSettled - True once brightness has held steady for a few frames
+ * Cameras often deliver black frames before auto-exposure starts, so a steady
+ * near-black image does not count as settled.
+ */
+static bool exposureSettled(double brightness, double &previous, int &stableFrames)
+{
+    if (previous >= 0 && std::fabs(brightness - previous) < 1.0 && brightness >= 8.0)
+        stableFrames++;
+    else
+        stableFrames = 0;
+    previous = brightness;
+    return stableFrames >= 3;
+}
 
 int main(int argc, char *argv[])
 {
-    cv::VideoCapture *capdev;
+    cv::VideoCapture *capdev = nullptr;
 
-    // Open default camera
-    capdev = new cv::VideoCapture(0);
-    if (!capdev->isOpened())
+    // Optional zero-copy capture: vidDisplay --v4l2 [device] [yuyv|nv12]
+    bool useV4L2 = false;
+    std::string v4l2Device = "/dev/video0";
+    FramePixelFormat v4l2Format = PIXFMT_YUYV;
+    if (argc > 1 && std::string(argv[1]) == "--v4l2")
     {
-        printf("ERROR: Unable to open video device\n");
-        return -1;
+        useV4L2 = true;
+        if (argc > 2 && argv[2][0] != '-')
+            v4l2Device = argv[2];
+        if (argc > 3 && std::string(argv[3]) == "nv12")
+            v4l2Format = PIXFMT_NV12;
     }
 
-    // Set camera resolution
-    capdev->set(cv::CAP_PROP_FRAME_WIDTH, 640);
-    capdev->set(cv::CAP_PROP_FRAME_HEIGHT, 480);
+    // Recorded footage instead of a camera: vidDisplay --replay <video>
+    std::string replayPath;
+    if (argc > 2 && std::string(argv[1]) == "--replay")
+    {
+        replayPath = argv[2];
+    }
 
-    // Warm up camera by capturing dummy frames
-    std::cout << "Initializing camera, please wait..." << std::endl;
-    cv::Mat dummy;
-    for (int i = 0; i < 30; i++)
+    // Options that may appear anywhere on the command line
+    std::string shmName;
+    bool headless = false;
+    std::string scriptedKeys;
+    // A benchmark key asked for the BGR frame while a luma-only effect was skipping it
+    bool colorRequested = false;
+    int previewPort = 0;
+    int previewWidth = 640;
+    int previewQuality = 70;
+    bool calibrateKernels = false;
+    double frameBudgetMs = 0;
+    std::vector<std::string> kernelOverrides;
+    for (int i = 1; i < argc; i++)
     {
-        *capdev >> dummy;
+        std::string arg = argv[i];
+        if (arg == "--headless")
+            headless = true;
+        else if (i + 1 < argc && arg == "--shm")
+            shmName = argv[i + 1];
+        else if (i + 1 < argc && arg == "--keys")
+            scriptedKeys = argv[i + 1];
+        else if (i + 1 < argc && arg == "--preview")
+            previewPort = atoi(argv[i + 1]);
+        else if (i + 1 < argc && arg == "--preview-width")
+            previewWidth = atoi(argv[i + 1]);
+        else if (i + 1 < argc && arg == "--preview-quality")
+            previewQuality = atoi(argv[i + 1]);
+        else if (arg == "--calibrate")
+            calibrateKernels = true;
+        else if (i + 1 < argc && arg == "--kernel")
+            kernelOverrides.push_back(argv[i + 1]);
+        else if (i + 1 < argc && arg == "--budget")
+            frameBudgetMs = atof(argv[i + 1]);
     }
-    std::cout << "Camera ready!" << std::endl;
+    if (headless)
+        std::signal(SIGINT, requestStop);
+
+    V4L2Capture v4l2Cap;
+    V4L2Frame v4l2Frame;
+    cv::Size refS;
+
+    // Cascade parsing, mask decoding and cache building overlap the camera warm-up,
+    // so the first face effect does not stall the render loop
+    std::thread preloader([]()
+    {
+        preloadFilterResources();
+        preloadFaceFeatureCascades();
+        std::cout << "Effect resources loaded at " << msSinceLaunch() << " ms" << std::endl;
+    });
 
-    cv::Size refS((int)capdev->get(cv::CAP_PROP_FRAME_WIDTH),
-                  (int)capdev->get(cv::CAP_PROP_FRAME_HEIGHT));
+    // Warm-up ends once exposure settles, bounded by the old fixed frame count
+    const int maxWarmupFrames = 30;
+    int warmupFrames = 0;
+    double lastBrightness = -1.0;
+    int stableFrames = 0;
+
+    if (useV4L2)
+    {
+        if (!v4l2Cap.open(v4l2Device, 640, 480, v4l2Format))
+        {
+            printf("ERROR: Unable to open V4L2 device %s\n", v4l2Device.c_str());
+            preloader.join();
+            return -1;
+        }
+
+        // Warm up camera until auto-exposure settles
+        std::cout << "Initializing camera, please wait..." << std::endl;
+        while (warmupFrames < maxWarmupFrames)
+        {
+            warmupFrames++;
+            if (!v4l2Cap.grab(v4l2Frame))
+                continue;
+
+            cv::Mat plane;
+            int stride = 1;
+            frameLumaView(v4l2Frame, plane, stride);
+            double brightness = sampledBrightness(plane, stride);
+            plane.release();
+            v4l2Cap.release(v4l2Frame);
+
+            if (exposureSettled(brightness, lastBrightness, stableFrames))
+                break;
+        }
+        std::cout << "Camera ready after " << warmupFrames << " warm-up frames" << std::endl;
+
+        refS = cv::Size(v4l2Cap.width(), v4l2Cap.height());
+    }
+    else if (!replayPath.empty())
+    {
+        // Footage needs no resolution request and no exposure warm-up
+        capdev = new cv::VideoCapture(replayPath);
+        if (!capdev->isOpened())
+        {
+            printf("ERROR: Unable to open %s\n", replayPath.c_str());
+            preloader.join();
+            return -1;
+        }
+
+        refS = cv::Size((int)capdev->get(cv::CAP_PROP_FRAME_WIDTH),
+                        (int)capdev->get(cv::CAP_PROP_FRAME_HEIGHT));
+    }
+    else
+    {
+        // Open default camera
+        capdev = new cv::VideoCapture(0);
+        if (!capdev->isOpened())
+        {
+            printf("ERROR: Unable to open video device\n");
+            preloader.join();
+            return -1;
+        }
+
+        // Set camera resolution
+        capdev->set(cv::CAP_PROP_FRAME_WIDTH, 640);
+        capdev->set(cv::CAP_PROP_FRAME_HEIGHT, 480);
+
+        // Warm up camera until auto-exposure settles
+        std::cout << "Initializing camera, please wait..." << std::endl;
+        cv::Mat dummy;
+        while (warmupFrames < maxWarmupFrames)
+        {
+            warmupFrames++;
+            *capdev >> dummy;
+            if (dummy.empty())
+                continue;
+
+            // All channel bytes of a continuous BGR frame, read as one wide gray image
+            if (exposureSettled(sampledBrightness(dummy.reshape(1), 1), lastBrightness, stableFrames))
+                break;
+        }
+        std::cout << "Camera ready after " << warmupFrames << " warm-up frames" << std::endl;
+
+        refS = cv::Size((int)capdev->get(cv::CAP_PROP_FRAME_WIDTH),
+                        (int)capdev->get(cv::CAP_PROP_FRAME_HEIGHT));
+    }
     printf("Camera opened successfully\n");
     printf("Resolution: %d x %d\n", refS.width, refS.height);
 
+    // Eight slots of one BGR frame each; readers that fall more than that behind skip ahead
+    SharedFrameRing frameRing;
+    if (!shmName.empty() && frameRing.create(shmName, 8, (size_t)refS.width * refS.height * 3))
+    {
+        std::cout << "Publishing frames to shared memory " << shmName << std::endl;
+    }
+
+    // Fastest grey/sepia/blur implementation per resolution, remembered across runs
+    AutoTuner kernelTuner("../data/kernelTuning.txt");
+    registerStandardVariants(kernelTuner);
+    for (size_t i = 0; i < kernelOverrides.size(); i++)
+    {
+        size_t split = kernelOverrides[i].find('=');
+        if (split != std::string::npos)
+            kernelTuner.setOverride(kernelOverrides[i].substr(0, split), kernelOverrides[i].substr(split + 1));
+    }
+
+    // JPEG encoding runs on its own threads and only while someone is watching
+    MjpegServer preview;
+    if (previewPort > 0 && preview.start(previewPort, previewWidth, previewQuality))
+    {
+        std::cout << "MJPEG preview on http://127.0.0.1:" << previewPort << "/" << std::endl;
+    }
+
     // Display keyboard controls
     std::cout << "\n=== Video Display Controls ===" << std::endl;
     std::cout << "q - Quit" << std::endl;
     std::cout << "s - Save current frame" << std::endl;
+    std::cout << "v - Start/stop recording the processed stream" << std::endl;
+    std::cout << "e - Toggle recorder backpressure (drop/block)" << std::endl;
     std::cout << "h - grayscale (Custom)" << std::endl;
     std::cout << "g - grayscale (OpenCV)" << std::endl;
     std::cout << "p - sepia tone" << std::endl;
@@ -56,22 +360,42 @@ int main(int argc, char *argv[])
     std::cout << "y - Sobel Y (horizontal edges)" << std::endl;
     std::cout << "m - gradient magnitude" << std::endl;
     std::cout << "l - blur quantize (cartoon effect)" << std::endl;
-    std::cout << "f - face detection" << std::endl;
+    std::cout << "+ / - - More/fewer cartoon color levels" << std::endl;
+    std::cout << "B - Toggle edge-preserving (bilateral grid) smoothing for cartoon and sketch" << std::endl;
+    std::cout << "f - face detection (with eyes and smiles)" << std::endl;
     std::cout << "d - depth map" << std::endl;
     std::cout << "t - depth focus (portrait mode)" << std::endl;
+    std::cout << "G - Toggle guided-filter depth refinement (depth map, depth focus)" << std::endl;
     std::cout << "k - sketch mode" << std::endl;
     std::cout << "i - spotlight face" << std::endl;
     std::cout << "n - glitch effect" << std::endl;
     std::cout << "c - color pop effect (cycles through R/G/B)" << std::endl;
     std::cout << "o - Spider-Man mask" << std::endl;
+    std::cout << "j - Effects mosaic (every effect at once)" << std::endl;
+    std::cout << "P - Pedestrian detection (people count)" << std::endl;
+    std::cout << ", / . - Detect people less/more often (tracking in between)" << std::endl;
+    std::cout << "Q - Adaptive quality (hold the frame budget by lowering scale, detection rate, blur, tiles)" << std::endl;
     std::cout << "z - Run blur timing test" << std::endl;
+    std::cout << "Z - Hardware counters per megapixel for every filter (Linux perf)" << std::endl;
+    std::cout << "a - Run magnitude mode speed/accuracy test" << std::endl;
+    std::cout << "r - Cycle processing scale (1, 1/2, 1/4) for depth focus, cartoon, spotlight" << std::endl;
+    std::cout << "u - Run reduced-resolution quality/speed test" << std::endl;
+    std::cout << "U - Bilateral grid vs cv::bilateralFilter at 720p/1080p" << std::endl;
+    std::cout << "D - Guided depth vs full-resolution Gaussian depth (time, edge alignment)" << std::endl;
+    std::cout << "w - Toggle dirty-tile skipping (sepia, blur, Sobel, cartoon, sketch)" << std::endl;
+    std::cout << "[ / ] - Lower/raise tile change threshold" << std::endl;
     std::cout << "\nStarting video stream..." << std::endl;
 
-    cv::namedWindow("Video", 1);
+    if (!headless)
+        cv::namedWindow("Video", 1);
     cv::Mat frame;
 
     int frameCount = 0;
     int savedCount = 0;
+    int recordingCount = 0;
+
+    // Snapshots and recordings are encoded on a background thread
+    FrameRecorder recorder(8, BACKPRESSURE_DROP);
 
     // Mode flags for each filter
     bool grayscaleMode = false;
@@ -92,113 +416,345 @@ int main(int argc, char *argv[])
     int colorChannel = 2;
     bool spidermanMode = false;
 
+    // All effects side by side, rendered on a worker pool from shared intermediates
+    bool mosaicMode = false;
+    EffectsMosaic mosaic;
+
+    // Eyes and smiles, searched only inside detected faces
+    FaceFeatureDetector featureDetector;
+    std::vector<FaceFeatures> features;
+
+    // People detection every few frames, tracking in between
+    bool pedestrianMode = false;
+    PedestrianDetector pedestrianDetector;
+    std::vector<TrackedPerson> people;
+    int peopleInterval = pedestrianDetector.getDetectInterval();
+
+    // Faces are re-detected every detectInterval frames and reused in between
+    std::vector<cv::Rect> spotlightFaces;
+    // Eye-aligned head rectangles for the Spider-Man mask, refilled every frame
+    std::vector<cv::Rect> alignedFaces;
+    int lastFaceDetectFrame = 0;
+    int lastFaceDetectMode = 0;
+
+    // Steps quality down when frames run over budget and back up when there is headroom
+    QualityController qualityController(frameBudgetMs > 0 ? frameBudgetMs : 33.0);
+    qualityController.setEnabled(frameBudgetMs > 0);
+
+    // Per-effect processing scale (1 = full resolution, 2 = half, 4 = quarter)
+    int depthFocusScale = 1;
+    int cartoonScale = 1;
+    int spotlightScale = 1;
+
+    // Cartoon color levels, adjustable with + / -
+    int cartoonLevels = 10;
+
+    // Cartoon and sketch smooth with the bilateral grid instead of a Gaussian, toggled with B
+    bool edgePreserving = false;
+
+    // Depth map and portrait mode fit depth to the frame's edges with the guided filter, toggled with G
+    bool guidedDepthMode = true;
+
+    // Dirty-tile skipping for static cameras: only changed tiles are re-rendered
+    bool tileSkipMode = false;
+    DirtyTileTracker tileTracker(32, 6);
+    cv::Mat tiledOutput;
+    int lastTiledEffect = 0;
+
+    // Buffers reused across frames so the steady-state loop does not allocate or clone
+    cv::Mat effectBuffer;
+    cv::Mat grayBuffer;
+    cv::Mat gradX, gradY;
+    cv::Mat depthBuffer;
+
+    // Text overlays are drawn into the top band of the shown frame
+    const int overlayBandHeight = 100;
+
     // Main capture and display loop
     for (;;)
     {
-        *capdev >> frame;
+        // The adaptive controller can only lower quality below what the keys selected
+        const QualitySettings &quality = qualityController.settings();
+        bool tilesOn = tileSkipMode || quality.tileSkip;
+        int effectiveDepthScale = std::max(depthFocusScale, quality.scale);
+        int effectiveCartoonScale = std::max(cartoonScale, quality.scale);
+        int effectiveSpotlightScale = std::max(spotlightScale, quality.scale);
+        pedestrianDetector.setDetectInterval(std::max(peopleInterval, quality.detectInterval));
+
+        // Luma-only effects read Y from the V4L2 buffer and never need a BGR frame
+        bool lumaOnlyMode = grayscaleMode || glitchMode || (sketchModeActive && !tilesOn && !edgePreserving);
+        // Calibration and the benchmark keys still need this frame in BGR
+        bool colorFrameFresh = !useV4L2 || !lumaOnlyMode || calibrateKernels || colorRequested;
+        colorRequested = false;
 
-        if (frame.empty())
+        if (useV4L2)
         {
-            printf("ERROR: Frame is empty\n");
-            break;
+            if (!v4l2Cap.grab(v4l2Frame))
+            {
+                printf("ERROR: Frame is empty\n");
+                break;
+            }
+            if (colorFrameFresh)
+            {
+                frameToBGR(v4l2Frame, frame);
+            }
+        }
+        else
+        {
+            *capdev >> frame;
+
+            if (frame.empty())
+            {
+                if (!replayPath.empty())
+                    printf("End of replay\n");
+                else
+                    printf("ERROR: Frame is empty\n");
+                break;
+            }
         }
 
         frameCount++;
+        auto processStart = std::chrono::high_resolution_clock::now();
+
+        // Face modes share the detection schedule; switching mode detects right away
+        int faceMode = faceDetectMode ? 1 : spotlightMode ? 2 : spidermanMode ? 3 : 0;
+        bool faceDetectDue = faceMode != lastFaceDetectMode ||
+                             frameCount - lastFaceDetectFrame >= quality.detectInterval;
+        if (faceDetectDue)
+        {
+            lastFaceDetectFrame = frameCount;
+            lastFaceDetectMode = faceMode;
+        }
+
+        if (calibrateKernels)
+        {
+            std::cout << "Calibrating filter variants..." << std::endl;
+            kernelTuner.calibrate(frame);
+            kernelTuner.printReport();
+            calibrateKernels = false;
+        }
 
-        cv::Mat displayFrame;
+        // Effects and overlays write into the reused buffer; frame stays as captured for the
+        // benchmark keys and the next frame's detectors
+        cv::Mat displayFrame = effectBuffer;
+        cv::Mat lumaPlane;
+        int lumaStride = 1;
+        if (useV4L2)
+        {
+            frameLumaView(v4l2Frame, lumaPlane, lumaStride);
+        }
+
+        // Stateless spatial filters can reuse unchanged tiles from the previous output
+        std::function<int(cv::Mat &, cv::Mat &)> tiledFilter;
+        int tiledEffect = 0;
+        int tileHalo = 0;
+        if (tilesOn)
+        {
+            if (sepiaMode)
+            {
+                tiledFilter = [](cv::Mat &src, cv::Mat &dst) { return sepia(src, dst); };
+                tiledEffect = 1;
+                tileHalo = 0;
+            }
+            else if (blurMode)
+            {
+                tiledFilter = [](cv::Mat &src, cv::Mat &dst) { return blur5x5_2(src, dst); };
+                tiledEffect = 2;
+                tileHalo = 2;
+            }
+            else if (sobelXMode || sobelYMode)
+            {
+                bool xDir = sobelXMode;
+                tiledFilter = [xDir](cv::Mat &src, cv::Mat &dst) {
+                    cv::Mat sobel;
+                    int result = xDir ? sobelX3x3(src, sobel) : sobelY3x3(src, sobel);
+                    cv::convertScaleAbs(sobel, dst);
+                    return result;
+                };
+                tiledEffect = xDir ? 3 : 4;
+                tileHalo = 1;
+            }
+            else if (blurQuantizeMode && !edgePreserving)
+            {
+                int levels = cartoonLevels;
+                tiledFilter = [levels](cv::Mat &src, cv::Mat &dst) { return blurQuantize(src, dst, levels); };
+                tiledEffect = 5;
+                tileHalo = 2;
+            }
+            else if (sketchModeActive && !edgePreserving)
+            {
+                tiledFilter = [](cv::Mat &src, cv::Mat &dst) { return sketchFilter(src, dst); };
+                tiledEffect = 6;
+                tileHalo = 1;
+            }
+        }
+
+        if (tiledEffect != lastTiledEffect)
+        {
+            tileTracker.invalidate();
+            lastTiledEffect = tiledEffect;
+        }
 
         // Apply selected filter
-        if (grayscaleMode)
+        if (tiledFilter)
+        {
+            tileTracker.update(frame);
+            applyTiled(tiledFilter, frame, tiledOutput, tileTracker, tileHalo);
+            // Shown directly; the tiles under the text overlays are re-rendered next frame
+            displayFrame = tiledOutput;
+        }
+        else if (mosaicMode)
+        {
+            mosaic.setCartoonLevels(cartoonLevels);
+            mosaic.render(frame, displayFrame);
+        }
+        else if (pedestrianMode)
+        {
+            pedestrianDetector.process(frame, people);
+            frame.copyTo(displayFrame);
+            for (size_t p = 0; p < people.size(); p++)
+            {
+                cv::rectangle(displayFrame, people[p].box, cv::Scalar(0, 200, 255), 2);
+                cv::putText(displayFrame, "#" + std::to_string(people[p].id), people[p].box.tl() + cv::Point(4, 18),
+                            cv::FONT_HERSHEY_SIMPLEX, 0.6, cv::Scalar(0, 200, 255), 2);
+            }
+        }
+        else if (grayscaleMode)
         {
-            cv::cvtColor(frame, displayFrame, cv::COLOR_BGR2GRAY);
-            cv::cvtColor(displayFrame, displayFrame, cv::COLOR_GRAY2BGR);
+            if (useV4L2)
+            {
+                lumaToBGR(lumaPlane, lumaStride, displayFrame);
+            }
+            else
+            {
+                cv::cvtColor(frame, grayBuffer, cv::COLOR_BGR2GRAY);
+                cv::cvtColor(grayBuffer, displayFrame, cv::COLOR_GRAY2BGR);
+            }
         }
         else if (customGrayscaleMode)
         {
-            greyscale(frame, displayFrame);
+            kernelTuner.run("grey", frame, displayFrame);
         }
         else if (sepiaMode)
         {
-            sepia(frame, displayFrame);
+            kernelTuner.run("sepia", frame, displayFrame);
         }
         else if (blurMode)
         {
-            blur5x5_2(frame, displayFrame);
+            kernelTuner.run("blur", frame, displayFrame);
         }
         else if (sobelXMode)
         {
-            cv::Mat sobelX;
-            sobelX3x3(frame, sobelX);
-            cv::convertScaleAbs(sobelX, displayFrame);
+            sobelX3x3(frame, gradX);
+            cv::convertScaleAbs(gradX, displayFrame);
         }
         else if (sobelYMode)
         {
-            cv::Mat sobelY;
-            sobelY3x3(frame, sobelY);
-            cv::convertScaleAbs(sobelY, displayFrame);
+            sobelY3x3(frame, gradY);
+            cv::convertScaleAbs(gradY, displayFrame);
         }
         else if (magnitudeMode)
         {
-            cv::Mat sobelX, sobelY;
-            sobelX3x3(frame, sobelX);
-            sobelY3x3(frame, sobelY);
-            magnitude(sobelX, sobelY, displayFrame);
+            sobelX3x3(frame, gradX);
+            sobelY3x3(frame, gradY);
+            // Bit-exact with the float path, without the float conversions
+            magnitude(gradX, gradY, displayFrame, MAGNITUDE_INT_SQRT);
         }
         else if (blurQuantizeMode)
         {
-            blurQuantize(frame, displayFrame, 10);
+            // The grid already works on a coarse lattice, so it runs at full resolution
+            if (edgePreserving)
+                blurQuantizeBilateral(frame, displayFrame, cartoonLevels);
+            else
+                blurQuantizeScaled(frame, displayFrame, cartoonLevels, effectiveCartoonScale);
         }
         else if (faceDetectMode)
         {
-            displayFrame = frame.clone();
-            std::vector<cv::Rect> faces;
-            detectFaces(frame, faces);
-            for (size_t i = 0; i < faces.size(); i++)
+            if (faceDetectDue)
+                detectFeaturesInFrame(useV4L2, v4l2Frame, frame, featureDetector, features);
+            frame.copyTo(displayFrame);
+            for (size_t f = 0; f < features.size(); f++)
             {
-                cv::rectangle(displayFrame, faces[i], cv::Scalar(0, 255, 0), 3);
+                cv::rectangle(displayFrame, features[f].face, cv::Scalar(0, 255, 0), 3);
+                for (size_t e = 0; e < features[f].eyes.size(); e++)
+                    cv::rectangle(displayFrame, features[f].eyes[e], cv::Scalar(255, 128, 0), 2);
+                for (size_t m = 0; m < features[f].smiles.size(); m++)
+                    cv::rectangle(displayFrame, features[f].smiles[m], cv::Scalar(0, 0, 255), 2);
             }
         }
         else if (depthMode)
         {
-            cv::Mat depth;
-            estimateDepth(frame, depth);
-            cv::applyColorMap(depth, displayFrame, cv::COLORMAP_TURBO);
+            if (guidedDepthMode)
+                guidedDepth(frame, depthBuffer);
+            else
+                estimateDepth(frame, depthBuffer);
+            cv::applyColorMap(depthBuffer, displayFrame, cv::COLORMAP_TURBO);
         }
         else if (depthFocusMode)
         {
-            cv::Mat depth;
-            estimateDepth(frame, depth);
-            depthFocusEffect(frame, depth, displayFrame);
+            depthFocusScaled(frame, displayFrame, effectiveDepthScale, quality.blurPasses, guidedDepthMode);
         }
         else if (sketchModeActive)
         {
-            sketchFilter(frame, displayFrame);
+            if (edgePreserving)
+            {
+                sketchBilateral(frame, displayFrame);
+            }
+            else if (useV4L2)
+            {
+                cv::Mat gray;
+                frameLuma(v4l2Frame, gray);
+                sketchFromLuma(gray, displayFrame);
+            }
+            else
+            {
+                sketchFilter(frame, displayFrame);
+            }
         }
         else if (spotlightMode)
         {
-            displayFrame = frame.clone();
-            std::vector<cv::Rect> faces;
-            detectFaces(frame, faces);
-            spotlightFace(frame, faces, displayFrame);
+            if (faceDetectDue)
+                detectFacesInFrame(useV4L2, v4l2Frame, frame, spotlightFaces);
+            spotlightFaceScaled(frame, spotlightFaces, displayFrame, effectiveSpotlightScale);
         }
         else if (glitchMode)
         {
-            glitchEffect(frame, displayFrame);
+            if (useV4L2)
+                glitchFromLuma(lumaPlane, lumaStride, displayFrame, frameCount);
+            else
+                glitchEffect(frame, displayFrame, frameCount);
         }
         else if (colorPopMode)
         {
-            colorPop(frame, displayFrame, colorChannel);
+            v2::colorPop(frame, displayFrame, colorChannel);
         }
         else if (spidermanMode)
         {
-            displayFrame = frame.clone();
-            std::vector<cv::Rect> faces;
-            detectFaces(frame, faces);
-            spidermanMask(frame, faces, displayFrame);
+            if (faceDetectDue)
+                detectFeaturesInFrame(useV4L2, v4l2Frame, frame, featureDetector, features);
+            // Heads are re-centred on the eyes when both were found, so the mask lines up with them
+            alignedFaces.clear();
+            for (size_t f = 0; f < features.size(); f++)
+                alignedFaces.push_back(alignedFace(features[f]));
+            v2::spidermanMask(frame, alignedFaces, displayFrame);
         }
         else
         {
-            displayFrame = frame.clone();
+            // The overlays below must not land in frame
+            frame.copyTo(displayFrame);
+        }
+
+        // Keep whatever buffer the effect produced for the next frame
+        if (displayFrame.data != tiledOutput.data)
+        {
+            effectBuffer = displayFrame;
+        }
+
+        // Filters are done with the driver buffer; hand it back
+        if (useV4L2)
+        {
+            lumaPlane.release();
+            v4l2Cap.release(v4l2Frame);
         }
 
         // Overlay frame count
@@ -223,9 +779,9 @@ int main(int argc, char *argv[])
         if (magnitudeMode)
             modeText = "Mode: Gradient Magnitude";
         if (blurQuantizeMode)
-            modeText = "Mode: Blur Quantize";
+            modeText = "Mode: Blur Quantize (" + std::to_string(cartoonLevels) + " levels)";
         if (faceDetectMode)
-            modeText = "Mode: Face Detection";
+            modeText = "Mode: Face Detection (eyes, smiles)";
         if (depthMode)
             modeText = "Mode: Depth Map";
         if (depthFocusMode)
@@ -243,19 +799,102 @@ int main(int argc, char *argv[])
         }
         if (spidermanMode)
             modeText = "Mode: Spider-Man Mask";
+        if (pedestrianMode)
+            modeText = "Mode: People " + std::to_string(people.size()) + " (detect every " +
+                       std::to_string(pedestrianDetector.getDetectInterval()) + ")";
+        if (mosaicMode)
+        {
+            char mosaicText[64];
+            snprintf(mosaicText, sizeof(mosaicText), "Mode: Effects Mosaic (%.1f ms)", mosaic.lastFrameMs());
+            modeText = mosaicText;
+        }
+        if ((blurQuantizeMode || sketchModeActive) && edgePreserving)
+            modeText += " (bilateral)";
+        if ((depthMode || depthFocusMode) && guidedDepthMode)
+            modeText += " (guided)";
+        if (blurQuantizeMode && effectiveCartoonScale > 1 && !edgePreserving)
+            modeText += " @1/" + std::to_string(effectiveCartoonScale);
+        if (depthFocusMode && effectiveDepthScale > 1)
+            modeText += " @1/" + std::to_string(effectiveDepthScale);
+        if (spotlightMode && effectiveSpotlightScale > 1)
+            modeText += " @1/" + std::to_string(effectiveSpotlightScale);
         cv::putText(displayFrame, modeText, cv::Point(10, 60),
                     cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(0, 255, 0), 2);
 
-        cv::imshow("Video", displayFrame);
+        if (tiledFilter)
+        {
+            char tileText[64];
+            snprintf(tileText, sizeof(tileText), "Tiles skipped: %.0f%% (thr %d)",
+                     tileTracker.lastSkippedPercent(), tileTracker.getThreshold());
+            cv::putText(displayFrame, tileText, cv::Point(10, 90),
+                        cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(0, 255, 0), 2);
+        }
 
-        // Check for keyboard input
-        int key = cv::waitKey(30);
+        if (qualityController.isEnabled())
+        {
+            char qualityText[96];
+            snprintf(qualityText, sizeof(qualityText), "Quality: L%d/%d (%.1f / %.0f ms)", qualityController.level(),
+                     qualityController.maxLevel(), qualityController.averageMs(), qualityController.getBudget());
+            cv::putText(displayFrame, qualityText, cv::Point(10, displayFrame.rows - 15),
+                        cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(0, 255, 255), 2);
+        }
+
+        qualityController.update(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - processStart).count() / 1000.0);
+
+        if (recorder.isRecording())
+        {
+            recorder.recordFrame(displayFrame);
+            cv::putText(displayFrame, "REC", cv::Point(displayFrame.cols - 70, 30),
+                        cv::FONT_HERSHEY_SIMPLEX, 0.7, cv::Scalar(0, 0, 255), 2);
+        }
+
+        if (frameRing.isOpened())
+        {
+            frameRing.publish(displayFrame);
+        }
+
+        preview.submit(displayFrame);
+
+        if (!headless)
+            cv::imshow("Video", displayFrame);
+
+        if (frameCount == 1)
+        {
+            std::cout << "Time to first frame: " << msSinceLaunch() << " ms" << std::endl;
+        }
+
+        if (tiledFilter)
+        {
+            tileTracker.invalidateRect(cv::Rect(0, 0, displayFrame.cols, overlayBandHeight));
+            tileTracker.invalidateRect(cv::Rect(0, displayFrame.rows - 40, displayFrame.cols, 40));
+        }
+
+        // Check for keyboard input; scripted keys come first, one per frame
+        int key = headless ? -1 : cv::waitKey(30);
+        if (!scriptedKeys.empty())
+        {
+            key = (unsigned char)scriptedKeys[0];
+            scriptedKeys.erase(0, 1);
+        }
+        if (stopRequested)
+            key = 'q';
 
         if (key >= 0)
         {
             key = key & 0xFF;
         }
 
+        // In luma-only mode frame is stale; convert the next frame and press the key again then
+        auto colorFrameReady = [&](int pressed) {
+            if (colorFrameFresh)
+                return true;
+            colorRequested = true;
+            scriptedKeys.insert(scriptedKeys.begin(), (char)pressed);
+            std::cout << "Luma-only mode: converting the next frame to BGR first" << std::endl;
+            return false;
+        };
+
         // Handle keyboard commands
         if (key == 'q' || key == 27)
         {
@@ -266,8 +905,36 @@ int main(int argc, char *argv[])
         {
             savedCount++;
             std::string filename = "../data/frame_" + std::to_string(savedCount) + ".jpg";
-            cv::imwrite(filename, displayFrame);
-            std::cout << "Saved: " << filename << std::endl;
+            if (!recorder.saveSnapshot(displayFrame, filename))
+            {
+                std::cout << "Encoder busy, snapshot dropped: " << filename << std::endl;
+            }
+        }
+        else if (key == 'v')
+        {
+            if (recorder.isRecording())
+            {
+                recorder.stopRecording();
+            }
+            else
+            {
+                recordingCount++;
+                recorder.startRecording("../data/recording_" + std::to_string(recordingCount) + ".avi", 30.0);
+                std::cout << "Recording: ON" << std::endl;
+            }
+        }
+        else if (key == 'e')
+        {
+            if (recorder.getPolicy() == BACKPRESSURE_DROP)
+            {
+                recorder.setPolicy(BACKPRESSURE_BLOCK);
+                std::cout << "Recorder backpressure: block" << std::endl;
+            }
+            else
+            {
+                recorder.setPolicy(BACKPRESSURE_DROP);
+                std::cout << "Recorder backpressure: drop" << std::endl;
+            }
         }
         else if (key == 'g')
         {
@@ -289,6 +956,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "OpenCV grayscale: ON" << std::endl;
             }
             else
@@ -316,6 +985,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Custom grayscale: ON" << std::endl;
             }
             else
@@ -343,6 +1014,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Sepia tone: ON" << std::endl;
             }
             else
@@ -370,6 +1043,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Blur: ON" << std::endl;
             }
             else
@@ -397,6 +1072,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Sobel X: ON" << std::endl;
             }
             else
@@ -424,6 +1101,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Sobel Y: ON" << std::endl;
             }
             else
@@ -451,6 +1130,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Gradient magnitude: ON" << std::endl;
             }
             else
@@ -478,6 +1159,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Blur quantize: ON" << std::endl;
             }
             else
@@ -505,6 +1188,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Face detection: ON" << std::endl;
             }
             else
@@ -532,6 +1217,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Depth map: ON" << std::endl;
             }
             else
@@ -559,6 +1246,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Depth focus: ON" << std::endl;
             }
             else
@@ -586,6 +1275,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Sketch mode: ON" << std::endl;
             }
             else
@@ -613,6 +1304,8 @@ int main(int argc, char *argv[])
                 glitchMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Spotlight face: ON" << std::endl;
             }
             else
@@ -640,6 +1333,8 @@ int main(int argc, char *argv[])
                 spotlightMode = false;
                 colorPopMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Glitch effect: ON" << std::endl;
             }
             else
@@ -667,6 +1362,8 @@ int main(int argc, char *argv[])
                 spotlightMode = false;
                 glitchMode = false;
                 colorPopMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Spider-Man mask: ON" << std::endl;
             }
             else
@@ -674,10 +1371,163 @@ int main(int argc, char *argv[])
                 std::cout << "Spider-Man mask: OFF" << std::endl;
             }
         }
+        else if (key == 'j')
+        {
+            mosaicMode = !mosaicMode;
+            if (mosaicMode)
+            {
+                grayscaleMode = false;
+                customGrayscaleMode = false;
+                sepiaMode = false;
+                blurMode = false;
+                sobelXMode = false;
+                sobelYMode = false;
+                magnitudeMode = false;
+                blurQuantizeMode = false;
+                faceDetectMode = false;
+                depthMode = false;
+                depthFocusMode = false;
+                sketchModeActive = false;
+                spotlightMode = false;
+                glitchMode = false;
+                colorPopMode = false;
+                spidermanMode = false;
+                pedestrianMode = false;
+                std::cout << "Effects mosaic: ON (" << mosaic.getEffectCount() << " effects)" << std::endl;
+            }
+            else
+            {
+                std::cout << "Effects mosaic: OFF" << std::endl;
+            }
+        }
+        else if (key == 'P')
+        {
+            pedestrianMode = !pedestrianMode;
+            if (pedestrianMode)
+            {
+                grayscaleMode = false;
+                customGrayscaleMode = false;
+                sepiaMode = false;
+                blurMode = false;
+                sobelXMode = false;
+                sobelYMode = false;
+                magnitudeMode = false;
+                blurQuantizeMode = false;
+                faceDetectMode = false;
+                depthMode = false;
+                depthFocusMode = false;
+                sketchModeActive = false;
+                spotlightMode = false;
+                glitchMode = false;
+                colorPopMode = false;
+                spidermanMode = false;
+                mosaicMode = false;
+                std::cout << "Pedestrian detection: ON" << std::endl;
+            }
+            else
+            {
+                std::cout << "Pedestrian detection: OFF" << std::endl;
+            }
+        }
+        else if (key == ',' || key == '.')
+        {
+            peopleInterval = std::max(1, peopleInterval + (key == ',' ? 1 : -1));
+            std::cout << "People detect interval: " << peopleInterval << " frames" << std::endl;
+        }
+        else if (key == 'Q')
+        {
+            qualityController.setEnabled(!qualityController.isEnabled());
+            std::cout << "Adaptive quality: " << (qualityController.isEnabled() ? "ON" : "OFF")
+                      << " (budget " << qualityController.getBudget() << " ms)" << std::endl;
+        }
+        else if (key == 'B')
+        {
+            edgePreserving = !edgePreserving;
+            std::cout << "Edge-preserving smoothing: " << (edgePreserving ? "ON" : "OFF") << std::endl;
+        }
+        else if (key == 'G')
+        {
+            guidedDepthMode = !guidedDepthMode;
+            std::cout << "Guided depth refinement: " << (guidedDepthMode ? "ON" : "OFF") << std::endl;
+        }
+        else if (key == 'D')
+        {
+            if (colorFrameReady(key))
+            {
+                testGuidedDepth(frame);
+            }
+        }
+        else if (key == 'U')
+        {
+            if (colorFrameReady(key))
+            {
+                testBilateralGrid(frame);
+            }
+        }
         else if (key == 'z')
         {
-            std::cout << "\nRunning blur timing test..." << std::endl;
-            testBlurTiming(frame);
+            if (colorFrameReady(key))
+            {
+                std::cout << "\nRunning blur timing test..." << std::endl;
+                testBlurTiming(frame);
+            }
+        }
+        else if (key == 'Z')
+        {
+            if (colorFrameReady(key))
+            {
+                testFilterCounters(frame);
+            }
+        }
+        else if (key == 'a')
+        {
+            if (colorFrameReady(key))
+            {
+                testMagnitudeModes(frame);
+            }
+        }
+        else if (key == 'r')
+        {
+            // Cycle 1 -> 1/2 -> 1/4 -> 1 for whichever scalable effect is active
+            int *scale = nullptr;
+            if (depthFocusMode) scale = &depthFocusScale;
+            else if (blurQuantizeMode) scale = &cartoonScale;
+            else if (spotlightMode) scale = &spotlightScale;
+
+            if (scale)
+            {
+                *scale = (*scale >= 4) ? 1 : *scale * 2;
+                std::cout << "Processing scale: 1/" << *scale << std::endl;
+            }
+            else
+            {
+                std::cout << "Processing scale applies to depth focus, cartoon and spotlight" << std::endl;
+            }
+        }
+        else if (key == '+' || key == '=' || key == '-')
+        {
+            cartoonLevels = std::max(2, std::min(32, cartoonLevels + (key == '-' ? -1 : 1)));
+            // Cached tiles were rendered with the old levels
+            tileTracker.invalidate();
+            std::cout << "Cartoon levels: " << cartoonLevels << std::endl;
+        }
+        else if (key == 'w')
+        {
+            tileSkipMode = !tileSkipMode;
+            std::cout << "Dirty-tile skipping: " << (tileSkipMode ? "ON" : "OFF") << std::endl;
+        }
+        else if (key == '[' || key == ']')
+        {
+            tileTracker.setThreshold(tileTracker.getThreshold() + (key == ']' ? 1 : -1));
+            std::cout << "Tile change threshold: " << tileTracker.getThreshold() << std::endl;
+        }
+        else if (key == 'u')
+        {
+            if (colorFrameReady(key))
+            {
+                std::cout << "\nRunning reduced-resolution test..." << std::endl;
+                testScaleQuality(frame);
+            }
         }
         else if (key == 'c')
         {
@@ -699,6 +1549,8 @@ int main(int argc, char *argv[])
                 spotlightMode = false;
                 glitchMode = false;
                 spidermanMode = false;
+                mosaicMode = false;
+                pedestrianMode = false;
                 std::cout << "Color pop: ON (Red channel)" << std::endl;
             } else {
                 // Cycle through colors
@@ -715,13 +1567,35 @@ int main(int argc, char *argv[])
                 }
             }
         }
+
+        // A face mode switched on by this key starts the first-detection clock
+        int nextFaceMode = faceDetectMode ? 1 : spotlightMode ? 2 : spidermanMode ? 3 : 0;
+        if (nextFaceMode != 0 && nextFaceMode != lastFaceDetectMode)
+        {
+            startFirstDetectionTimer();
+        }
     }
 
+    preloader.join();
     delete capdev;
-    cv::destroyAllWindows();
+    v4l2Cap.close();
+    if (!headless)
+        cv::destroyAllWindows();
 
     std::cout << "Total frames processed: " << frameCount << std::endl;
-    std::cout << "Images saved: " << savedCount << std::endl;
+    // Wait for queued snapshots and the recording to hit the disk
+    recorder.finish();
+    recorder.printStats();
+    tileTracker.printStats();
+    mosaic.printStats();
+    featureDetector.printStats();
+    pedestrianDetector.printStats();
+    frameRing.printStats();
+    frameRing.close();
+    preview.stop();
+    preview.printStats();
+    kernelTuner.printReport();
+    qualityController.printStats();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+/*
+ * Shamya Haria
+ * October 18, 2026
+ *
+ * CS 5330 - Project 1
+ *
+ * workStealingPool.cpp
+ * Per-worker deques with stealing from the opposite end.
+ */
+
+#include "workStealingPool.h"
+#include <algorithm>
+
+// Which pool and deque the current thread works for, so nested submits stay local
+thread_local const WorkStealingPool *currentPool = nullptr;
+thread_local int currentQueue = -1;
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : queued(0), stopping(false), nextQueue(0), executed(0), stolen(0) {
+    if (threadCount <= 0) {
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&WorkStealingPool::run, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+        stopping = true;
+    }
+    idle.notify_all();
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    int target;
+    if (currentPool == this) {
+        target = currentQueue;
+    } else {
+        target = (int)(nextQueue.fetch_add(1) % queues.size());
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+
+    // Counted under idleLock so a worker cannot miss it between its check and its wait
+    {
+        std::lock_guard<std::mutex> guard(idleLock);
+        queued++;
+    }
+    idle.notify_one();
+}
+
+/*
+ * takeTask - Newest task from our own deque, else the oldest from the next non-empty victim
+ */
+bool WorkStealingPool::takeTask(int self, std::function<void()> &task) {
+    {
+        Queue &own = *queues[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+
+    int count = (int)queues.size();
+    for (int k = 1; k < count; k++) {
+        Queue &victim = *queues[(self + k) % count];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued--;
+            stolen++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run(int self) {
+    currentPool = this;
+    currentQueue = self;
+
+    for (;;) {
+        std::function<void()> task;
+        if (takeTask(self, task)) {
+            task();
+            executed++;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> guard(idleLock);
+        idle.wait(guard, [&] { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}